@@ -3,6 +3,9 @@
 //
 
 #include "Binary.h"
+#include "Natural.h"
+#include "Instrumentation.h"
+#include "DivisorU64.h"
 #include <limits> // size_type max
 
 /**
@@ -12,6 +15,54 @@ namespace {
     // Binary sign definitions
     constexpr Binary::value_type negative = 1;
     constexpr Binary::value_type positive = 0;
+
+    typedef Binary::limb_container limb_container;
+
+    using kernels::limbs_for;
+
+    // two's complement negation of little-endian limbs
+    void negate(limb_container& limbs) {
+        kernels::limb_type carry = 1;
+        for (auto& limb : limbs) {
+            limb = ~limb + carry;
+            carry = carry && limb == 0;
+        }
+    }
+
+    // number of limbs without the leading zero limbs
+    Binary::size_type significant(const limb_container& limbs) {
+        Binary::size_type n = limbs.size();
+        while (n > 0 && limbs[n - 1] == 0) { --n; }
+        return n;
+    }
+
+    // smallest two's complement precision holding the value of the sign-extended limbs
+    Binary::size_type signed_bits(const limb_container& limbs) {
+        const bool sign = !limbs.empty() && (limbs.back() >> (kernels::limb_bits - 1));
+        const kernels::limb_type fill = sign ? ~kernels::limb_type(0) : 0;
+        for (Binary::size_type i = limbs.size(); i-- > 0;) {
+            if (limbs[i] != fill) {
+                Binary::size_type bit = kernels::limb_bits - 1;
+                while (((limbs[i] >> bit) & 1) == sign) { --bit; }
+                return i * kernels::limb_bits + bit + 2;
+            }
+        }
+        return 1;
+    }
+
+    // true if the bits of the top limb from bit prec - 1 upward are not all equal, i.e. the value needs more than prec bits
+    bool exceeds(kernels::limb_type top, Binary::size_type prec) {
+        const Binary::size_type used = prec % kernels::limb_bits;
+        if (used == 0) { return false; }
+        const kernels::limb_type high = top >> (used - 1);
+        return high != 0 && high != (~kernels::limb_type(0) >> (used - 1));
+    }
+
+    // precision of a dynamic result: prec if the exact value fits, otherwise enough whole limbs to hold it
+    Binary::size_type grown(const limb_container& exact, Binary::size_type prec) {
+        const Binary::size_type bits = signed_bits(exact);
+        return bits <= prec ? prec : limbs_for(bits) * kernels::limb_bits;
+    }
 }
 
 
@@ -105,6 +156,34 @@ void Binary::reserve(size_type n) {
     }
 }
 
+/**
+ * \brief Dynamic storage: promotes the precision to hold the given amount of bits, rounded up to whole limbs.
+ * The capacity grows geometrically, so that steadily growing values rarely reallocate.
+ */
+void Binary::grow(size_type bits) {
+    if (bits <= precision()) { return; }
+    const size_type prec = limbs_for(bits) * kernels::limb_bits;
+    if (digits.capacity() < prec) {
+        digits.reserve(std::max(prec, 2 * digits.capacity()));
+    }
+    set_precision(prec);
+}
+
+/**
+ * \brief True if an operation on a and b has to grow instead of wrapping.
+ */
+bool Binary::dynamic(const Binary& a, const Binary& b) {
+    return a.storage_type == StorageType::Dynamic || b.storage_type == StorageType::Dynamic;
+}
+
+/**
+ * \brief Moves the digits into or out of shared storage. Leaving it copies them only if a copy still shares them.
+ */
+void Binary::set_copy_mode(CopyModes mode) {
+    if (mode == CopyModes::Shared) { digits.share(); }
+    else { digits.unshare(); }
+}
+
 /**
  * \brief Flips all bits.
  */
@@ -124,17 +203,132 @@ void Binary::clear() {
 }
 
 Binary Binary::absVal() const {
+    LMPA_INSTRUMENT(AbsVal, precision());
     if (this->sign()) { return -*this; }
     return *this;
 }
 
 
+/// Limb Conversion ///
+
+/**
+ * \brief Returns the value as n little-endian limbs. Will sign-extend or truncate the value as necessary.
+ */
+Binary::limb_container Binary::to_limbs(size_type n) const {
+    limb_container result(n, 0);
+    if (precision() == 0) { return result; }
+
+    const size_type bits = std::min(precision(), n * kernels::limb_bits);
+    auto iter = std::end(digits);
+    for (size_type i = 0; i < bits; ++i) {
+        if (*--iter) {
+            result[i / kernels::limb_bits] |= kernels::limb_type(1) << (i % kernels::limb_bits);
+        }
+    }
+
+    if (sign() && bits < n * kernels::limb_bits) {
+        // fill the remaining bits with the sign
+        size_type i = bits / kernels::limb_bits;
+        if (bits % kernels::limb_bits) {
+            result[i++] |= ~kernels::limb_type(0) << (bits % kernels::limb_bits);
+        }
+        for (; i < n; ++i) {
+            result[i] = ~kernels::limb_type(0);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * \brief Sets the value to the lowest prec bits of the given little-endian limbs, and the precision to prec.
+ * Bits beyond the given limbs are taken as 0.
+ */
+void Binary::assign_limbs(const limb_container& limbs, size_type prec) {
+    digits.resize(prec);
+    const size_type bits = std::min(prec, limbs.size() * kernels::limb_bits);
+    auto iter = std::end(digits);
+    for (size_type i = 0; i < bits; ++i) {
+        *--iter = (limbs[i / kernels::limb_bits] >> (i % kernels::limb_bits)) & 1;
+    }
+    while (iter != std::begin(digits)) {
+        *--iter = 0;
+    }
+    _precision = prec;
+}
+
+/**
+ * \brief Returns the absolute value as little-endian limbs, without leading zero limbs.
+ */
+Binary::limb_container Binary::magnitude() const {
+    limb_container result = to_limbs(limbs_for(precision()));
+    if (precision() && sign()) { negate(result); }
+    result.resize(significant(result));
+    return result;
+}
+
+/**
+ * \brief Creates a Binary from the magnitude and the sign. The precision will be the smallest one
+ * holding the value, but at least min_prec.
+ */
+Binary Binary::from_magnitude(const limb_container& limbs, bool negative, size_type min_prec) {
+    const size_type n = significant(limbs);
+    size_type bits = 0;
+    if (n) {
+        bits = (n - 1) * kernels::limb_bits;
+        for (kernels::limb_type top = limbs[n - 1]; top; top >>= 1) { ++bits; }
+    }
+    const size_type prec = std::max(bits + 1, min_prec);
+
+    limb_container value(limbs.begin(), limbs.begin() + n);
+    value.resize(limbs_for(prec), 0);
+    if (negative) { negate(value); }
+
+    Binary result(prec);
+    result.assign_limbs(value, prec);
+    return result;
+}
+
+/**
+ * \brief Returns the lowest n limbs of a * b. The magnitudes are multiplied with their actual sizes,
+ * so that a small operand is not sign-extended to the size of the large one.
+ */
+Binary::limb_container Binary::multiply_limbs(const Binary& a, const Binary& b, size_type n, ThreadPool* pool) {
+    limb_container left = a.to_limbs(n);
+    if (a.sign()) { negate(left); }
+    const size_type ln = significant(left);
+
+    if (&a == &b) {
+        // x * x is squared, which needs about half the limb products
+        limb_container result(2 * ln, 0);
+        if (ln) {
+            kernels::sqr(result.data(), left.data(), ln, pool);
+        }
+        result.resize(n, 0);
+        return result;
+    }
+
+    limb_container right = b.to_limbs(n);
+    if (b.sign()) { negate(right); }
+    const size_type rn = significant(right);
+    limb_container result(ln + rn, 0);
+    if (ln && rn) {
+        kernels::mul(result.data(), left.data(), ln, right.data(), rn, pool);
+    }
+    result.resize(n, 0);
+
+    if (a.sign() != b.sign()) { negate(result); }
+    return result;
+}
+
+
 /// Assignment ///
 
 /**
  * \brief Assignment Operator. Will promote the assigned-to object accordingly.
  */
 Binary& Binary::operator=(const Binary& b) {
+    LMPA_INSTRUMENT(Assign, precision() + b.precision());
     if (this == &b) {
         return *this;
     }
@@ -159,8 +353,9 @@ Binary& Binary::operator=(const Binary& b) {
 
 /**
  * \brief Move assignment operator. Will promote the assigned-to object accordingly.
+ * Copies, and may throw std::bad_alloc, if the digits of either side are shared.
  */
-Binary& Binary::operator=(Binary&& b) noexcept {
+Binary& Binary::operator=(Binary&& b) {
     if (this == &b) {
         return *this;
     }
@@ -190,86 +385,56 @@ Binary& Binary::operator=(Binary&& b) noexcept {
  * \brief Addition Assignment Operator. Will promote the assigned-to object accordingly.
  */
 Binary& Binary::operator+=(const Binary& b) {
+    LMPA_INSTRUMENT(Add, precision() + b.precision());
     // promote this to the higher precision of the two
     this->reserve(std::max(this->precision(), b.precision()));
 
-    // iterate from right to left, iterators must always point one to the right of the current object
-    auto leftiter = std::end(this->digits);
-    auto rightiter = std::end(b.digits);
-
-    bool add = false;
-
-    while (leftiter > std::begin(this->digits) + 1 && rightiter > std::begin(b.digits) + 1) {
-        value_type sum = *(leftiter - 1) ^ *(rightiter - 1) ^ add;
-        add = (*(leftiter - 1) + *(rightiter - 1) + add) > 1;
-        *(leftiter - 1) = sum;
-        --leftiter;
-        --rightiter;
-    }
-
-    while (leftiter > std::begin(this->digits)) {
-        // this can be of higher precision than b, but not the other way around
-        value_type sum = *(leftiter - 1) ^add ^b.sign();
-        add = (*(leftiter - 1) + add + b.sign()) > 1;
-        *(leftiter - 1) = sum;
-        --leftiter;
-    }
+    // a dynamic sum is computed with room for the carry out of the sign bit
+    const bool grows = dynamic(*this, b);
+    const size_type n = limbs_for(grows ? precision() + 1 : precision());
+    limb_container left = this->to_limbs(n);
+    const limb_container right = b.to_limbs(n);
+    kernels::add_n(left.data(), left.data(), right.data(), n);
+    if (grows) { this->grow(signed_bits(left)); }
+    this->assign_limbs(left, precision());
 
     return *this;
 }
 
 /**
- * \brief Subtraction Assignment Operator. See Implementation for operator+=
+ * \brief Subtraction Assignment Operator. Will promote the assigned-to object accordingly.
  */
 Binary& Binary::operator-=(const Binary& b) {
-    return *this += (-b);
+    LMPA_INSTRUMENT(Subtract, precision() + b.precision());
+    // promote this to the higher precision of the two
+    this->reserve(std::max(this->precision(), b.precision()));
+
+    // a dynamic sum is computed with room for the carry out of the sign bit
+    const bool grows = dynamic(*this, b);
+    const size_type n = limbs_for(grows ? precision() + 1 : precision());
+    limb_container left = this->to_limbs(n);
+    const limb_container right = b.to_limbs(n);
+    kernels::sub_n(left.data(), left.data(), right.data(), n);
+    if (grows) { this->grow(signed_bits(left)); }
+    this->assign_limbs(left, precision());
+
+    return *this;
 }
 
 /**
  * \brief Multiplication Assignment Operator. Will promote the assigned-to object accordingly.
  */
 Binary& Binary::operator*=(const Binary& b) {
+    LMPA_INSTRUMENT(Multiply, precision() + b.precision());
     // promote this to the higher precision of the two
     this->reserve(std::max(this->precision(), b.precision()));
 
-    auto rightiter = std::end(b.digits);
-
-    std::vector<container_type> sums;
-    sums.reserve(b.precision()); // worst-case allocation (b is all ones)
-
-    // collect all vectors to add and bring them in appropriate form
-    while (rightiter > std::begin(b.digits) + 1) {
-        if (*(rightiter - 1)) {
-            container_type temp(std::begin(digits) + (std::end(b.digits) - rightiter), std::end(digits));
-            // TODO: Test
-            // add zeroes to end of vector corresponding with current index
-            temp.insert(std::end(temp), static_cast<size_type>(std::end(b.digits) - rightiter), 0);
-            // add vector to sums
-            sums.emplace_back(temp);
-        }
-        --rightiter;
-    }
-
-    sums.shrink_to_fit();
-
-    // clear the original digits before adding to them
-    this->clear();
-
-    // add the vectors
-    for (const auto& vec : sums) {
-        // this will always be shorter than, or of equivalent length as vec
-        auto leftiter = std::end(digits);
-        rightiter = std::end(vec);
-
-        bool add = false;
-        while (leftiter > std::begin(digits) && rightiter > std::begin(vec)) {
-            value_type sum = *(leftiter - 1) ^*(rightiter - 1) ^add;
-            add = (*(leftiter - 1) + *(rightiter - 1) + add) > 1;
-            *(leftiter - 1) = sum;
-            --leftiter;
-            --rightiter;
-        }
-    }
+    // a dynamic product is computed in full, it fits into the sum of the precisions
+    const bool grows = dynamic(*this, b);
+    const size_type n = limbs_for(grows ? precision() + b.precision() : precision());
+    const limb_container result = multiply_limbs(*this, b, n, nullptr);
+    if (grows) { this->grow(signed_bits(result)); }
+    this->assign_limbs(result, precision());
 
     return *this;
 }
@@ -278,6 +443,7 @@ Binary& Binary::operator*=(const Binary& b) {
  * \brief Division Assignment Operator. Will promote the assigned-to object accordingly.
  */
 Binary& Binary::operator/=(const Binary& b) noexcept(false) {
+    LMPA_INSTRUMENT(Divide, precision() + b.precision());
     // TODO: Optimize this (mainly by avoiding copies)
     bool divbyzero = true;
     for (const value_type d : b.digits) {
@@ -333,6 +499,7 @@ Binary& Binary::operator/=(const Binary& b) noexcept(false) {
  * \brief Modulo Assignment Operator. Will promote the assigned-to object accordingly.
  */
 Binary& Binary::operator%=(const Binary& b) {
+    LMPA_INSTRUMENT(Modulo, precision() + b.precision());
     // TODO: Optimize this (mainly by avoiding copies)
     bool divbyzero = true;
     for (const value_type d : b.digits) {
@@ -381,10 +548,16 @@ Binary& Binary::operator%=(const Binary& b) {
 }
 
 /**
- * \brief Left-Shift Assignment Operator. Will not alter the object's precision.
+ * \brief Left-Shift Assignment Operator. Will not alter the object's precision, unless it is dynamic.
  * If n is greater than the object's precision, the behavior is undefined.
  */
 Binary& Binary::operator<<=(const size_type n) {
+    LMPA_INSTRUMENT(ShiftLeft, precision());
+    if (storage_type == StorageType::Dynamic) {
+        // the significant bits of the value plus n
+        const auto first = std::find(std::begin(digits), std::end(digits), !sign());
+        grow(static_cast<size_type>(std::end(digits) - first) + 1 + n);
+    }
     digits.erase(std::begin(digits), std::begin(digits) + n);
     digits.insert(std::end(digits), n, 0);
     return *this;
@@ -395,6 +568,7 @@ Binary& Binary::operator<<=(const size_type n) {
  * If n is greater than the object's precision, the behavior is undefined.
  */
 Binary& Binary::operator>>=(const size_type n) {
+    LMPA_INSTRUMENT(ShiftRight, precision());
     digits.erase(std::end(digits) - n, std::end(digits));
     digits.insert(std::begin(digits), n, 0);
     return *this;
@@ -407,7 +581,13 @@ Binary& Binary::operator>>=(const size_type n) {
  * \brief Prefix-Increment Operator.
  */
 Binary Binary::operator++() {
+    LMPA_INSTRUMENT(Increment, precision());
     // prefix
+    if (storage_type == StorageType::Dynamic && !sign()
+        && std::find(std::begin(digits) + 1, std::end(digits), 0) == std::end(digits)) {
+        // the maximum value
+        grow(precision() + 1);
+    }
     // add one to the vector
     for (auto iter = std::end(digits); iter-- > std::begin(digits); /* no increment */) {
         if (!(*iter)) {
@@ -423,7 +603,13 @@ Binary Binary::operator++() {
  * \brief Prefix-Decrement Operator.
  */
 Binary Binary::operator--() {
+    LMPA_INSTRUMENT(Decrement, precision());
     // prefix
+    if (storage_type == StorageType::Dynamic && sign()
+        && std::find(std::begin(digits) + 1, std::end(digits), 1) == std::end(digits)) {
+        // the minimum value
+        grow(precision() + 1);
+    }
     // subtract one from the vector
     for (auto iter = std::end(digits); iter-- > std::begin(digits); /* no increment */) {
         if (*iter) {
@@ -439,6 +625,7 @@ Binary Binary::operator--() {
  * \brief Postfix-Increment Operator.
  */
 const Binary Binary::operator++(int) {
+    LMPA_INSTRUMENT(Increment, precision());
     // postfix
     Binary result = *this;
     ++(*this);
@@ -449,6 +636,7 @@ const Binary Binary::operator++(int) {
  * \brief Postfix-Decrement Operator.
  */
 const Binary Binary::operator--(int) {
+    LMPA_INSTRUMENT(Decrement, precision());
     // postfix
     Binary result = *this;
     --(*this);
@@ -469,6 +657,15 @@ Binary Binary::operator+() const {
  * \brief Inerts the sign of a copy of the Binary.
  */
 Binary Binary::operator-() const {
+    LMPA_INSTRUMENT(Negate, precision());
+    if (storage_type == StorageType::Dynamic && sign()
+        && std::find(std::begin(digits) + 1, std::end(digits), 1) == std::end(digits)) {
+        // the minimum value has no positive counterpart at the same precision
+        Binary copy(*this);
+        copy.grow(precision() + 1);
+        return -copy;
+    }
+
     container_type result = digits;
     // flip all bits
     result.flip();
@@ -485,107 +682,189 @@ Binary Binary::operator-() const {
         *iter = 0;
     }
 
-    return Binary(result);
-
+    Binary negated(result);
+    negated.storage_type = storage_type;
+    return negated;
 }
 
 /**
- * \brief Addition Operator. The result will be of the maximum precision of the two arguments.
+ * \brief Addition Operator. The result will be of the maximum precision of the two arguments,
+ * unless a dynamic result overflows it.
  */
 Binary Binary::operator+(const Binary& b) const {
-    // iterate from right to left, iterators must always point one to the right of the current element
-    auto leftiter = std::end(digits);
-    auto rightiter = std::end(b.digits);
-
-    container_type result;
-    if (std::is_same<container_type, std::vector<value_type>>::value) {
-        result.reserve(std::max(this->precision(), b.precision()));
-    }
-
-    bool add = false;
-
-    while (leftiter > std::begin(digits) + 1 && rightiter > std::begin(b.digits) + 1) {
-        result.emplace_back(*(leftiter - 1) ^ *(rightiter - 1) ^ add);
-        add = (*(leftiter - 1) + *(rightiter - 1) + add) > 1;
-        --leftiter;
-        --rightiter;
-    }
-
-    // get the sign of the shorter number and "pad" the number with it
-    // also need to decrement the corresponding index by one to prevent double calculation in below while statements
-    value_type buffer = (this->precision() > b.precision()) ? (*(--rightiter)) : (*(--leftiter));
+    LMPA_INSTRUMENT(Add, precision() + b.precision());
+    const bool grows = dynamic(*this, b);
+    size_type prec = std::max(this->precision(), b.precision());
+    // a dynamic sum is computed with room for the carry out of the sign bit
+    const size_type n = limbs_for(grows ? prec + 1 : prec);
+
+    limb_container left = this->to_limbs(n);
+    const limb_container right = b.to_limbs(n);
+    kernels::add_n(left.data(), left.data(), right.data(), n);
+    if (grows) { prec = grown(left, prec); }
+
+    Binary result(prec);
+    if (grows) { result.storage_type = StorageType::Dynamic; }
+    result.assign_limbs(left, prec);
+    return result;
+}
 
-    while (leftiter > std::begin(digits)) {
-        result.emplace_back(*(leftiter - 1) ^ buffer ^ add);
-        add = (*(leftiter - 1) + buffer + add) > 1;
-        --leftiter;
-    }
+/**
+ * \brief Subtraction Operator. The result will be of the maximum precision of the two arguments,
+ * unless a dynamic result overflows it.
+ */
+Binary Binary::operator-(const Binary& b) const {
+    LMPA_INSTRUMENT(Subtract, precision() + b.precision());
+    const bool grows = dynamic(*this, b);
+    size_type prec = std::max(this->precision(), b.precision());
+    // a dynamic sum is computed with room for the carry out of the sign bit
+    const size_type n = limbs_for(grows ? prec + 1 : prec);
+
+    limb_container left = this->to_limbs(n);
+    const limb_container right = b.to_limbs(n);
+    kernels::sub_n(left.data(), left.data(), right.data(), n);
+    if (grows) { prec = grown(left, prec); }
+
+    Binary result(prec);
+    if (grows) { result.storage_type = StorageType::Dynamic; }
+    result.assign_limbs(left, prec);
+    return result;
+}
 
-    while (rightiter > std::begin(b.digits)) {
-        result.emplace_back(*(rightiter - 1) ^ buffer ^ add);
-        add = (*(rightiter - 1) + buffer + add);
-        --rightiter;
-    }
+/**
+ * \brief Multiplication Operator. The result will be of the maximum precision of the two arguments,
+ * unless a dynamic result overflows it.
+ */
+Binary Binary::operator*(const Binary& b) const {
+    LMPA_INSTRUMENT(Multiply, precision() + b.precision());
+    const bool grows = dynamic(*this, b);
+    size_type prec = std::max(this->precision(), b.precision());
+    // a dynamic product is computed in full, it fits into the sum of the precisions
+    const size_type n = limbs_for(grows ? this->precision() + b.precision() : prec);
+    const limb_container product = multiply_limbs(*this, b, n, nullptr);
+    if (grows) { prec = grown(product, prec); }
+
+    Binary result(prec);
+    if (grows) { result.storage_type = StorageType::Dynamic; }
+    result.assign_limbs(product, prec);
+    return result;
+}
 
-    std::reverse(std::begin(result), std::end(result));
-    return Binary(result);
+/**
+ * \brief Squaring. Same result as *this * *this, which is squared as well.
+ */
+Binary Binary::sqr() const {
+    LMPA_INSTRUMENT(Multiply, 2 * precision());
+    return *this * *this;
 }
 
 /**
- * \brief Subtraction Operator. See Implementation for operator+
+ * \brief Multiplication with the pool. The result will be of the maximum precision of the two arguments,
+ * and identical to a * b.
  */
-Binary Binary::operator-(const Binary& b) const {
-    return *this + (-b);
+Binary multiply(const Binary& a, const Binary& b, ThreadPool& pool) {
+    LMPA_INSTRUMENT(Multiply, a.precision() + b.precision());
+    const bool grows = Binary::dynamic(a, b);
+    Binary::size_type prec = std::max(a.precision(), b.precision());
+    const Binary::size_type n = limbs_for(grows ? a.precision() + b.precision() : prec);
+    const Binary::limb_container product = Binary::multiply_limbs(a, b, n, &pool);
+    if (grows) { prec = grown(product, prec); }
+
+    Binary result(prec);
+    if (grows) { result.storage_type = Binary::StorageType::Dynamic; }
+    result.assign_limbs(product, prec);
+    return result;
 }
 
+
+/// Exact Division ///
+
 /**
- * \brief Multiplication Operator. The result will be of the maximum precision of the two arguments.
+ * \brief Exact division of the magnitudes, of the maximum precision of the two arguments like a / b.
+ * Dynamic storage grows to hold the quotient instead of wrapping it.
  */
-Binary Binary::operator*(const Binary& b) const {
-    // TODO: Consider using shifts to multiply as seen here: https://www.cs.utah.edu/~rajeev/cs3810/slides/3810-08.pdf
+Binary Binary::exact_quotient(const Binary& a, const Binary& b, ThreadPool* pool) noexcept(false) {
+    LMPA_INSTRUMENT(Divide, a.precision() + b.precision());
+    const limb_container q = natural::divexact(a.magnitude(), b.magnitude(), pool);
+    const bool grows = dynamic(a, b);
+    size_type prec = std::max(a.precision(), b.precision());
+
+    limb_container value(q);
+    value.resize(std::max(limbs_for(prec), q.size() + 1), 0);
+    if (a.sign() != b.sign()) { negate(value); }
+    if (grows) { prec = grown(value, prec); }
+
+    Binary result(prec);
+    if (grows) { result.storage_type = StorageType::Dynamic; }
+    result.assign_limbs(value, prec);
+    return result;
+}
 
-    auto rightiter = std::end(b.digits);
+Binary divexact(const Binary& a, const Binary& b) noexcept(false) {
+    return Binary::exact_quotient(a, b, nullptr);
+}
 
-    std::vector<container_type> sums;
-    sums.reserve(b.precision()); // worst-case allocation (b is all ones)
-
-    // collect all vectors to add and bring them in appropriate form
-    while (rightiter > std::begin(b.digits) + 1) {
-        if (*(rightiter - 1)) {
-            container_type temp(std::begin(digits) + (std::end(b.digits) - rightiter), std::end(digits));
-            // add zeroes to end of vector corresponding with current index
-            temp.insert(std::end(temp), static_cast<size_type>(std::end(b.digits) - rightiter), 0);
-            // if temp is still smaller than the larger of the two precisions, pad it with its sign
-            if (temp.size() < b.precision()) {
-                temp.insert(std::begin(temp), b.precision() - temp.size(), this->sign());
-            }
-            // add vector to sums
-            sums.emplace_back(temp);
-        }
-        --rightiter;
-    }
+Binary divexact(const Binary& a, const Binary& b, ThreadPool& pool) noexcept(false) {
+    return Binary::exact_quotient(a, b, &pool);
+}
 
-    sums.shrink_to_fit();
 
-    // add all vectors (need to have resulting vector of appropriate size from the beginning)
-    container_type result(std::max(this->precision(), b.precision()), 0);
+/// Checked Arithmetic ///
 
-    for (const auto& vec : sums) {
-        // result will always be shorter than, or of equivalent length as vec
-        auto leftiter = std::end(result);
-        rightiter = std::end(vec);
+/**
+ * \brief Checked Addition. The sum of the sign-extended limbs overflows the top limb if both signs are equal
+ * and differ from the sign of the sum, otherwise only the unused bits of the top limb have to be checked.
+ */
+bool add_overflow(Binary& dst, const Binary& a, const Binary& b) {
+    const Binary::size_type prec = std::max(a.precision(), b.precision());
+    const Binary::size_type n = limbs_for(prec);
+    const bool sa = a.sign(), sb = b.sign();
+
+    Binary::limb_container left = a.to_limbs(n);
+    const Binary::limb_container right = b.to_limbs(n);
+    kernels::add_n(left.data(), left.data(), right.data(), n);
+
+    const bool sr = left.back() >> (kernels::limb_bits - 1);
+    const bool overflow = (sa == sb && sr != sa) || exceeds(left.back(), prec);
+    dst.assign_limbs(left, prec);
+    return overflow;
+}
 
-        bool add = false;
-        while (leftiter > std::begin(result) && rightiter > std::begin(vec)) {
-            value_type sum = *(leftiter - 1) ^*(rightiter - 1) ^add;
-            add = (*(leftiter - 1) + *(rightiter - 1) + add) > 1;
-            *(leftiter - 1) = sum;
-            --leftiter;
-            --rightiter;
-        }
-    }
+/**
+ * \brief Checked Subtraction. See add_overflow, the difference overflows the top limb if the signs differ
+ * and the sign of the difference is not that of a.
+ */
+bool sub_overflow(Binary& dst, const Binary& a, const Binary& b) {
+    const Binary::size_type prec = std::max(a.precision(), b.precision());
+    const Binary::size_type n = limbs_for(prec);
+    const bool sa = a.sign(), sb = b.sign();
+
+    Binary::limb_container left = a.to_limbs(n);
+    const Binary::limb_container right = b.to_limbs(n);
+    kernels::sub_n(left.data(), left.data(), right.data(), n);
+
+    const bool sr = left.back() >> (kernels::limb_bits - 1);
+    const bool overflow = (sa != sb && sr != sa) || exceeds(left.back(), prec);
+    dst.assign_limbs(left, prec);
+    return overflow;
+}
 
-    return Binary(result);
+/**
+ * \brief Checked Multiplication. The kernel produces the full product of the magnitudes anyway,
+ * so overflow is read off its high limbs: the magnitude has to be below 2^(prec - 1), or equal to it if negative.
+ */
+bool mul_overflow(Binary& dst, const Binary& a, const Binary& b) {
+    const Binary::size_type prec = std::max(a.precision(), b.precision());
+    Binary::limb_container product = natural::mul(a.magnitude(), b.magnitude());
+    const bool negative = a.sign() != b.sign() && !product.empty();
+
+    const Binary::size_type bits = natural::bit_length(product);
+    const bool overflow = bits >= prec && !(negative && bits == prec && !natural::any_below(product, prec - 1));
+
+    product.resize(limbs_for(prec), 0);
+    if (negative) { negate(product); }
+    dst.assign_limbs(product, prec);
+    return overflow;
 }
 
 /**
@@ -593,6 +872,7 @@ Binary Binary::operator*(const Binary& b) const {
  * May throw if the divisor has a value of 0.
  */
 Binary Binary::operator/(const Binary& b) const noexcept(false) {
+    LMPA_INSTRUMENT(Divide, precision() + b.precision());
     // TODO: Optimize this (mainly by avoiding copies)
     bool divbyzero = true;
     for (const value_type d : b.digits) {
@@ -641,11 +921,27 @@ Binary Binary::operator/(const Binary& b) const noexcept(false) {
 
 }
 
+/**
+ * \brief Division by a divisor with a precomputed reciprocal, with multiplications only. The quotient keeps
+ * the precision and cannot overflow, as the divisor is positive.
+ */
+kernels::limb_type Binary::divrem(const DivisorU64& d) {
+    LMPA_INSTRUMENT(Divide, precision() + kernels::limb_bits);
+    const bool negative = sign();
+    limb_container limbs = magnitude();
+    const kernels::limb_type r = d.divrem(limbs.data(), limbs.data(), limbs.size());
+    limbs.resize(limbs_for(precision()) + 1, 0);
+    if (negative) { negate(limbs); }
+    this->assign_limbs(limbs, precision());
+    return r;
+}
+
 /**
  * \brief Modulo Operator. The result will be of the maximum precision of the two arguments.
  * May throw if the divisor has a value of 0.
  */
 Binary Binary::operator%(const Binary& b) const {
+    LMPA_INSTRUMENT(Modulo, precision() + b.precision());
     // TODO: Optimize this (mainly by avoiding copies)
     bool divbyzero = true;
     for (const value_type d : b.digits) {
@@ -697,6 +993,7 @@ Binary Binary::operator%(const Binary& b) const {
  * \brief Stream Output Operator. Will either print Two's-Complement or a Signed Binary, depending on printmode.
  */
 std::ostream& operator<<(std::ostream& stream, const Binary& b) {
+    LMPA_INSTRUMENT(Print, b.precision());
     if (b.printmode == Binary::PrintModes::Signed) {
         // show as regular binary number with sign instead of first bit
         if (b.sign()) {
@@ -724,6 +1021,7 @@ std::ostream& operator<<(std::ostream& stream, const Binary& b) {
  * \brief Comparison Operator. Compares bit by bit from the right.
  */
 bool Binary::operator==(const Binary& b) const {
+    LMPA_INSTRUMENT(Compare, precision() + b.precision());
     if (this->sign() != b.sign()) {
         return false;
     }
@@ -755,6 +1053,7 @@ bool Binary::operator==(const Binary& b) const {
  * \brief Anti-Comparison-Operator. See Implementation for operator==
  */
 bool Binary::operator!=(const Binary& b) const {
+    LMPA_INSTRUMENT(Compare, precision() + b.precision());
     return !(*this == b);
 }
 
@@ -762,6 +1061,7 @@ bool Binary::operator!=(const Binary& b) const {
  * \brief Left-Hand-Comparison Operator. Compares bit by bit.
  */
 bool Binary::operator<(const Binary& b) const {
+    LMPA_INSTRUMENT(Compare, precision() + b.precision());
     // compare signs first
     if (!this->sign() && b.sign()) {
         // this is positive, b is negative
@@ -778,7 +1078,8 @@ bool Binary::operator<(const Binary& b) const {
     while (this->precision() - (leftiter - std::begin(digits)) > b.precision()) {
         // this->digits is longer than b.digits
         if (*leftiter != this->sign()) {
-            return !this->sign();
+            // a leading one makes a positive number larger, a leading zero makes a negative number smaller
+            return this->sign();
         }
         ++leftiter;
     }
@@ -794,7 +1095,8 @@ bool Binary::operator<(const Binary& b) const {
     while (leftiter < std::end(this->digits)) {
         // iterators are synchronized
         if (*leftiter != *rightiter) {
-            return this->sign() ^ (*leftiter < *rightiter);
+            // signs are equal, so the remaining bits compare the same way for both signs
+            return *leftiter < *rightiter;
         }
         ++leftiter;
         ++rightiter;
@@ -808,6 +1110,7 @@ bool Binary::operator<(const Binary& b) const {
  * \brief Right-Hand-Comparison Operator. See Implementation for operator== and operator<
  */
 bool Binary::operator>(const Binary& b) const {
+    LMPA_INSTRUMENT(Compare, precision() + b.precision());
     return (!(*this < b) && !(*this == b));
 }
 
@@ -815,6 +1118,7 @@ bool Binary::operator>(const Binary& b) const {
  * \brief Left-Hand-Equality-Comparison Operator. See Implementation for operator>
  */
 bool Binary::operator<=(const Binary& b) const {
+    LMPA_INSTRUMENT(Compare, precision() + b.precision());
     return !(*this > b);
 }
 
@@ -822,6 +1126,7 @@ bool Binary::operator<=(const Binary& b) const {
  * \brief Right-Hand-Equality-Comparison Operator. See Implementation for operator<
  */
 bool Binary::operator>=(const Binary& b) const {
+    LMPA_INSTRUMENT(Compare, precision() + b.precision());
     return !(*this < b);
 }
 
@@ -829,9 +1134,12 @@ bool Binary::operator>=(const Binary& b) const {
  * \brief Left-Shift-Operator. Will Promote the copy by n digits.
  */
 Binary Binary::operator<<(const size_type n) const {
+    LMPA_INSTRUMENT(ShiftLeft, precision());
     container_type result = this->digits;
     result.insert(result.end(), n, 0);
-    return Binary(result);
+    Binary shifted(result);
+    shifted.storage_type = storage_type;
+    return shifted;
 }
 
 /**
@@ -839,10 +1147,13 @@ Binary Binary::operator<<(const size_type n) const {
  * If n is greater than the object's precision, the behavior is undefined.
  */
 Binary Binary::operator>>(const size_type n) const {
+    LMPA_INSTRUMENT(ShiftRight, precision());
     container_type result = this->digits;
     result.erase(std::end(result) - n, std::end(result));
     result.insert(std::begin(result), n, 0);
-    return Binary(result);
+    Binary shifted(result);
+    shifted.storage_type = storage_type;
+    return shifted;
 }
 
 /**
@@ -862,3 +1173,133 @@ bool Binary::operator&&(const Binary& b) const {
 bool Binary::operator||(const Binary& b) const {
     return !!*this || !!b;
 }
+
+
+/// Scalar Arithmetic ///
+
+/**
+ * \brief Adds a signed scalar by rippling it into the lowest bits, which leaves the rest of the digits untouched
+ * as soon as the carry or borrow stops. A dynamic Binary whose sign flipped although the operands had the same sign
+ * has overflowed and grows, with the lost sign restored above the old precision.
+ */
+Binary& Binary::add_scalar(const Scalar& x) {
+    LMPA_INSTRUMENT(Add, precision() + x.bits);
+    this->reserve(x.bits);
+    const bool grows = storage_type == StorageType::Dynamic;
+    if (grows) {
+        // room for the magnitude and a sign bit
+        size_type bits = 1;
+        while (bits < kernels::limb_bits && (x.magnitude >> bits)) { ++bits; }
+        this->reserve(bits + 1);
+    }
+
+    const value_type before = sign();
+    if (x.negative) {
+        sub_low(x.magnitude);
+    } else {
+        add_low(x.magnitude);
+    }
+
+    if (grows && before == x.negative && sign() != before) {
+        const size_type prec = precision();
+        this->grow(prec + 1);
+        std::fill(std::begin(digits), std::end(digits) - prec, before);
+    }
+    return *this;
+}
+
+/**
+ * \brief Multiplies the limbs by the magnitude with a single-limb multiplication and negates for negative scalars.
+ */
+Binary& Binary::mul_scalar(const Scalar& x) {
+    LMPA_INSTRUMENT(Multiply, precision() + x.bits);
+    this->reserve(x.bits);
+
+    // a dynamic product is computed in full, it fits into one more limb
+    const bool grows = storage_type == StorageType::Dynamic;
+    const size_type n = limbs_for(precision()) + (grows ? 1 : 0);
+    limb_container limbs = this->to_limbs(n);
+    kernels::mul_1(limbs.data(), limbs.data(), n, x.magnitude);
+    if (x.negative) { negate(limbs); }
+    if (grows) { this->grow(signed_bits(limbs)); }
+    this->assign_limbs(limbs, precision());
+    return *this;
+}
+
+Binary& Binary::div_scalar(const Scalar& x) noexcept(false) {
+    LMPA_INSTRUMENT(Divide, precision() + x.bits);
+    return divrem_scalar(x, false);
+}
+
+Binary& Binary::mod_scalar(const Scalar& x) noexcept(false) {
+    LMPA_INSTRUMENT(Modulo, precision() + x.bits);
+    return divrem_scalar(x, true);
+}
+
+/**
+ * \brief Truncating division of the magnitude by a single limb. Only the quotient of the most negative value
+ * by -1 can exceed the precision, it wraps unless the Binary is dynamic.
+ */
+Binary& Binary::divrem_scalar(const Scalar& x, bool remainder) noexcept(false) {
+    if (x.magnitude == 0) {
+        throw div_by_zero_error();
+    }
+    this->reserve(x.bits);
+
+    const bool negative = sign();
+    limb_container limbs = magnitude();
+    const kernels::limb_type r = limbs.empty() ? 0 : kernels::divrem_1(limbs.data(), limbs.data(), limbs.size(), x.magnitude);
+    if (remainder) { limbs.assign(1, r); }
+
+    limbs.resize(limbs_for(precision()) + 1, 0);
+    if (remainder ? negative : negative != x.negative) { negate(limbs); }
+    if (storage_type == StorageType::Dynamic) { this->grow(signed_bits(limbs)); }
+    this->assign_limbs(limbs, precision());
+    return *this;
+}
+
+/**
+ * \brief Compares by value. Binaries with more than 65 significant bits are beyond every scalar,
+ * the others are compared as 128-bit two's complement values.
+ */
+int Binary::compare_scalar(const Scalar& x) const {
+    LMPA_INSTRUMENT(Compare, precision() + x.bits);
+    if (precision() > 2 * kernels::limb_bits) {
+        const auto first = std::find(std::begin(digits), std::end(digits), !sign());
+        if (std::end(digits) - first > static_cast<std::ptrdiff_t>(kernels::limb_bits + 1)) {
+            return sign() ? -1 : 1;
+        }
+    }
+
+    const limb_container limbs = this->to_limbs(2);
+    const kernels::limb_type xlow = x.negative ? 0 - x.magnitude : x.magnitude;
+    const kernels::limb_type xhigh = x.negative ? ~kernels::limb_type(0) : 0;
+    if (limbs[1] != xhigh) {
+        // the high limbs as signed values
+        const kernels::limb_type flip = kernels::limb_type(1) << (kernels::limb_bits - 1);
+        return (limbs[1] ^ flip) < (xhigh ^ flip) ? -1 : 1;
+    }
+    if (limbs[0] != xlow) { return limbs[0] < xlow ? -1 : 1; }
+    return 0;
+}
+
+void Binary::add_low(kernels::limb_type m) {
+    kernels::limb_type carry = 0;
+    for (auto iter = std::end(digits); iter != std::begin(digits) && (m || carry); m >>= 1) {
+        --iter;
+        const kernels::limb_type sum = static_cast<kernels::limb_type>(*iter) + (m & 1) + carry;
+        *iter = sum & 1;
+        carry = sum >> 1;
+    }
+}
+
+void Binary::sub_low(kernels::limb_type m) {
+    kernels::limb_type borrow = 0;
+    for (auto iter = std::end(digits); iter != std::begin(digits) && (m || borrow); m >>= 1) {
+        --iter;
+        const kernels::limb_type bit = static_cast<kernels::limb_type>(*iter);
+        const kernels::limb_type subtrahend = (m & 1) + borrow;
+        *iter = (bit - subtrahend) & 1;
+        borrow = bit < subtrahend;
+    }
+}
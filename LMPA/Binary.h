@@ -12,8 +12,15 @@
 #include <vector> // container, size_t
 #include <iostream> // operator<< stream overload, size_t
 #include <algorithm> // reverse
+#include <type_traits> // scalar overloads
+
+#include "Kernels.h"
+#include "SharedContainer.h"
 
 class LMPA;
+class BinaryBatch;
+class ThreadPool;
+class DivisorU64;
 
 class div_by_zero_error : public std::runtime_error {
 private:
@@ -25,17 +32,16 @@ public:
     }
 };
 
-// TODO: Introduce static vs dynamic storage type (don't use different container_types)
-
 class Binary {
 
     friend class LMPA;
+    friend class BinaryBatch;
 
 public:
     typedef bool                                    value_type;
     typedef std::size_t                             size_type;
     // has to be a dynamic container
-    typedef std::vector<value_type>                 container_type;
+    typedef std::vector<value_type, instrumentation::Allocator<value_type>> container_type;
 
 
     /// Constructors ///
@@ -85,11 +91,40 @@ public:
 
     PrintModes printmode = PrintModes::Twos_Complement;
 
+    enum class StorageType {
+        Static, // static precision, results wrap around and the user has to reserve enough precision beforehand
+        Dynamic // addition, subtraction, multiplication and shifts increase the precision in whole limbs on overflow
+    };
+
+    // operations grow if either operand is dynamic, and so are the results of the non-assigning operators
+    StorageType storage_type = StorageType::Static;
+
+    enum class CopyModes {
+        Deep, // copies duplicate the digits
+        Shared // copies share the digits through a reference count, the first write to any of them copies them
+    };
+
+    // copies inherit the mode, an assigned-to object keeps its own. Results of the arithmetic operators are deep.
+    // Shared digits may be read and copied from multiple threads at once
+    void set_copy_mode(CopyModes mode);
+    inline CopyModes copy_mode() const { return digits.is_shared() ? CopyModes::Shared : CopyModes::Deep; }
+
+    /// Limb Conversion ///
+    typedef kernels::container_type                 limb_container;
+    // n little-endian limbs of the value, sign-extended or truncated
+    limb_container to_limbs(size_type n) const;
+    // sets the value to the lowest prec bits of the limbs and the precision to prec
+    void assign_limbs(const limb_container& limbs, size_type prec);
+    // little-endian limbs of the absolute value, without leading zero limbs
+    limb_container magnitude() const;
+    // smallest Binary of at least min_prec bits holding the (negated) magnitude
+    static Binary from_magnitude(const limb_container& limbs, bool negative, size_type min_prec = 32);
+
 
     /// Assignment ///
     // all assignment operators may safely promote the assigned-to object's precision
     Binary& operator=(const Binary& b);
-    Binary& operator=(Binary&& b) noexcept;
+    Binary& operator=(Binary&& b);
     Binary& operator+=(const Binary& b);
     Binary& operator-=(const Binary& b);
     Binary& operator*=(const Binary& b);
@@ -116,6 +151,9 @@ public:
     Binary operator*(const Binary& b) const;
     Binary operator/(const Binary& b) const noexcept(false);
     Binary operator%(const Binary& b) const;
+    Binary sqr() const;
+    // truncating division by a precomputed divisor, returns the magnitude of the remainder, whose sign is the dividend's
+    kernels::limb_type divrem(const DivisorU64& d);
     // shifting
     Binary operator<<(const std::size_t n) const;
     Binary operator>>(const std::size_t n) const;
@@ -136,8 +174,52 @@ public:
     bool operator<=(const Binary& b) const;
     bool operator>=(const Binary& b) const;
 
+    /// Scalar Arithmetic ///
+    // with any integral type except bool, promoting the precision like Binary(x, true) would, but taking x by value,
+    // so that unsigned scalars are never negative. Division truncates, remainders have the sign of the dividend
+    template<typename T>
+    using if_integral = typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type;
+
+    template<typename T, if_integral<T> = 0>
+    Binary& operator+=(T x) { return add_scalar(scalar(x, std::is_signed<T>())); }
+    template<typename T, if_integral<T> = 0>
+    Binary& operator-=(T x) { return add_scalar(scalar(x, std::is_signed<T>()).negated()); }
+    template<typename T, if_integral<T> = 0>
+    Binary& operator*=(T x) { return mul_scalar(scalar(x, std::is_signed<T>())); }
+    template<typename T, if_integral<T> = 0>
+    Binary& operator/=(T x) noexcept(false) { return div_scalar(scalar(x, std::is_signed<T>())); }
+    template<typename T, if_integral<T> = 0>
+    Binary& operator%=(T x) noexcept(false) { return mod_scalar(scalar(x, std::is_signed<T>())); }
+
+    template<typename T, if_integral<T> = 0>
+    Binary operator+(T x) const { return Binary(*this) += x; }
+    template<typename T, if_integral<T> = 0>
+    Binary operator-(T x) const { return Binary(*this) -= x; }
+    template<typename T, if_integral<T> = 0>
+    Binary operator*(T x) const { return Binary(*this) *= x; }
+    template<typename T, if_integral<T> = 0>
+    Binary operator/(T x) const noexcept(false) { return Binary(*this) /= x; }
+    template<typename T, if_integral<T> = 0>
+    Binary operator%(T x) const noexcept(false) { return Binary(*this) %= x; }
+
+    template<typename T, if_integral<T> = 0>
+    bool operator==(T x) const { return compare_scalar(scalar(x, std::is_signed<T>())) == 0; }
+    template<typename T, if_integral<T> = 0>
+    bool operator!=(T x) const { return compare_scalar(scalar(x, std::is_signed<T>())) != 0; }
+    template<typename T, if_integral<T> = 0>
+    bool operator<(T x) const { return compare_scalar(scalar(x, std::is_signed<T>())) < 0; }
+    template<typename T, if_integral<T> = 0>
+    bool operator>(T x) const { return compare_scalar(scalar(x, std::is_signed<T>())) > 0; }
+    template<typename T, if_integral<T> = 0>
+    bool operator<=(T x) const { return compare_scalar(scalar(x, std::is_signed<T>())) <= 0; }
+    template<typename T, if_integral<T> = 0>
+    bool operator>=(T x) const { return compare_scalar(scalar(x, std::is_signed<T>())) >= 0; }
+
 
     friend std::ostream& operator<< (std::ostream& stream, const Binary& b);
+    friend Binary multiply(const Binary& a, const Binary& b, ThreadPool& pool);
+    friend Binary divexact(const Binary& a, const Binary& b) noexcept(false);
+    friend Binary divexact(const Binary& a, const Binary& b, ThreadPool& pool) noexcept(false);
 
     // for debug purposes
     void print() const {
@@ -149,9 +231,63 @@ public:
 
 private:
     size_type _precision = 32; // bits, including the sign
-    container_type digits;
+    SharedContainer<container_type> digits;
+
+    static limb_container multiply_limbs(const Binary& a, const Binary& b, size_type n, ThreadPool* pool);
+    static Binary exact_quotient(const Binary& a, const Binary& b, ThreadPool* pool) noexcept(false);
+    static bool dynamic(const Binary& a, const Binary& b);
+    void grow(size_type bits);
+
+    // a primitive integer as magnitude and sign, with the precision Binary(x, true) would have
+    struct Scalar {
+        kernels::limb_type magnitude;
+        bool negative;
+        size_type bits;
+
+        Scalar negated() const { return {magnitude, magnitude != 0 && !negative, bits}; }
+    };
+
+    template<typename T>
+    static Scalar scalar(T x, std::true_type) {
+        const auto value = static_cast<long long>(x);
+        const auto magnitude = static_cast<kernels::limb_type>(value);
+        return {value < 0 ? 0 - magnitude : magnitude, value < 0, sizeof(T) * 8};
+    }
+    template<typename T>
+    static Scalar scalar(T x, std::false_type) {
+        return {static_cast<kernels::limb_type>(x), false, sizeof(T) * 8};
+    }
+
+    Binary& add_scalar(const Scalar& x);
+    Binary& mul_scalar(const Scalar& x);
+    Binary& div_scalar(const Scalar& x) noexcept(false);
+    Binary& mod_scalar(const Scalar& x) noexcept(false);
+    // the quotient or, if remainder is set, the remainder
+    Binary& divrem_scalar(const Scalar& x, bool remainder) noexcept(false);
+    int compare_scalar(const Scalar& x) const;
+    // adds or subtracts m at the lowest bits, rippling the carry only as far as it goes
+    void add_low(kernels::limb_type m);
+    void sub_low(kernels::limb_type m);
 
 };
 
+/// Parallel Arithmetic ///
+// same result as a * b, with the subproducts of large operands computed on the pool
+Binary multiply(const Binary& a, const Binary& b, ThreadPool& pool);
+
+/// Exact Division ///
+// a / b for b dividing a, like a / b but from the low end at about the cost of a multiplication.
+// The result is unspecified if b does not divide a. Throws div_by_zero_error if b is 0
+Binary divexact(const Binary& a, const Binary& b) noexcept(false);
+// the same with the products of large operands computed on the pool
+Binary divexact(const Binary& a, const Binary& b, ThreadPool& pool) noexcept(false);
+
+/// Checked Arithmetic ///
+// dst = a op b, wrapped at the maximum precision of a and b regardless of the storage type,
+// returns true if the exact result does not fit into that precision. dst may be a or b
+bool add_overflow(Binary& dst, const Binary& a, const Binary& b);
+bool sub_overflow(Binary& dst, const Binary& a, const Binary& b);
+bool mul_overflow(Binary& dst, const Binary& a, const Binary& b);
+
 
 #endif //LMPA_LIBRARY_BINARY_H
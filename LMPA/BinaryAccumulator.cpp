@@ -0,0 +1,100 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "BinaryAccumulator.h"
+#include "SignMagnitudeBinary.h"
+#include "Natural.h"
+#include "Instrumentation.h"
+
+typedef BinaryAccumulator::limb_type limb_type;
+typedef BinaryAccumulator::size_type size_type;
+typedef BinaryAccumulator::container_type container_type;
+
+constexpr size_type BinaryAccumulator::slice_values;
+
+
+/// Column ///
+
+/**
+ * \brief Adds the magnitude limb by limb. A carry out of a limb is counted in the next one instead of rippling,
+ * the counts cannot overflow for less than 2^64 additions.
+ */
+void BinaryAccumulator::Column::add(const container_type& a) {
+    if (sum.size() <= a.size()) {
+        sum.resize(a.size() + 1, 0);
+        carries.resize(a.size() + 1, 0);
+    }
+    for (size_type i = 0; i < a.size(); ++i) {
+        sum[i] += a[i];
+        carries[i + 1] += sum[i] < a[i];
+    }
+}
+
+void BinaryAccumulator::Column::add(const Column& other) {
+    add(other.sum);
+    for (size_type i = 0; i < other.carries.size(); ++i) {
+        carries[i] += other.carries[i];
+    }
+}
+
+container_type BinaryAccumulator::Column::normalized() const {
+    container_type s = sum, c = carries;
+    natural::normalize(s);
+    natural::normalize(c);
+    return natural::add(s, c);
+}
+
+
+/// Assignment ///
+
+void BinaryAccumulator::accumulate(const Binary& b, bool subtract) {
+    LMPA_INSTRUMENT(Add, b.precision());
+    prec = std::max(prec, b.precision());
+    grows = grows || b.storage_type == Binary::StorageType::Dynamic;
+    (b.sign() != subtract ? negative : positive).add(b.magnitude());
+}
+
+BinaryAccumulator& BinaryAccumulator::operator+=(const Binary& b) {
+    accumulate(b, false);
+    return *this;
+}
+
+BinaryAccumulator& BinaryAccumulator::operator-=(const Binary& b) {
+    accumulate(b, true);
+    return *this;
+}
+
+BinaryAccumulator& BinaryAccumulator::operator+=(const BinaryAccumulator& other) {
+    positive.add(other.positive);
+    negative.add(other.negative);
+    prec = std::max(prec, other.prec);
+    grows = grows || other.grows;
+    return *this;
+}
+
+
+/// Utility ///
+
+/**
+ * \brief Resolves the carries of both columns and subtracts their totals. A static sum is truncated to the precision
+ * of the widest value, independently of the order of the values, so that partial sums can be merged.
+ */
+Binary BinaryAccumulator::value() const {
+    if (prec == 0) { return Binary(); }
+    SignMagnitudeBinary total(positive.normalized(), false);
+    total -= SignMagnitudeBinary(negative.normalized(), false);
+
+    size_type result_prec = prec;
+    if (grows && total.precision() > prec) {
+        result_prec = kernels::limbs_for(total.precision()) * kernels::limb_bits;
+    }
+    Binary result = total.to_binary(result_prec);
+    result.set_precision(result_prec);
+    if (grows) { result.storage_type = Binary::StorageType::Dynamic; }
+    return result;
+}
+
+void BinaryAccumulator::clear() {
+    *this = BinaryAccumulator();
+}
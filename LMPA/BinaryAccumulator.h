@@ -0,0 +1,114 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_BINARYACCUMULATOR_H
+#define LMPA_LIBRARY_BINARYACCUMULATOR_H
+
+#include <vector> // columns, partial sums
+#include <iterator> // distance, next
+#include <algorithm> // min
+
+#include "Binary.h"
+#include "ThreadPool.h"
+
+/**
+ * \brief A sum of many Binaries with deferred carries. Each value is added limb by limb into a column of the
+ * magnitudes of its sign, and the carry out of a limb is only counted, so that an addition costs the size of the value
+ * instead of the size of the sum. Carries and signs are resolved once by value(). Accumulators of partial sums
+ * may be merged, which sum() does for the slices of a range summed on a thread pool.
+ */
+class BinaryAccumulator {
+public:
+    typedef kernels::limb_type                      limb_type;
+    typedef kernels::size_type                      size_type;
+    typedef kernels::container_type                 container_type;
+
+    // values per slice of a parallel sum, below a slice is not worth handing to the pool
+    static constexpr size_type slice_values = 64;
+
+    /// Constructors ///
+    BinaryAccumulator() = default;
+
+    BinaryAccumulator(const BinaryAccumulator& other) = default;
+    BinaryAccumulator(BinaryAccumulator&& other) = default;
+
+    ~BinaryAccumulator() = default;
+
+    /// Assignment ///
+    BinaryAccumulator& operator=(const BinaryAccumulator& other) = default;
+    BinaryAccumulator& operator=(BinaryAccumulator&& other) = default;
+    BinaryAccumulator& operator+=(const Binary& b);
+    BinaryAccumulator& operator-=(const Binary& b);
+    // merges the partial sum of another accumulator
+    BinaryAccumulator& operator+=(const BinaryAccumulator& other);
+
+    /// Utility ///
+    // the exact sum reduced modulo 2^P, P being the maximum precision of the values. This differs from a chain of +=
+    // if a prefix of narrower values wraps before a wider value widens the chain. If any value is dynamic, so is
+    // the sum, which then grows in whole limbs instead of wrapping. The sum of no values is Binary()
+    Binary value() const;
+    void clear();
+
+private:
+    // magnitudes added without carrying, carries[i] counts the carries into sum[i]
+    struct Column {
+        container_type sum;
+        container_type carries;
+
+        void add(const container_type& a);
+        void add(const Column& other);
+        container_type normalized() const;
+    };
+
+    Column positive, negative;
+    size_type prec = 0; // of the widest value, 0 before the first one
+    bool grows = false;
+
+    void accumulate(const Binary& b, bool subtract);
+
+};
+
+/// Summation ///
+// the exact sum of the range in the precision of value(), normalized once at the end
+template<typename Iterator>
+Binary sum(Iterator first, Iterator last) {
+    BinaryAccumulator accumulator;
+    for (; first != last; ++first) {
+        accumulator += *first;
+    }
+    return accumulator.value();
+}
+
+// the same with slices of the range summed on the pool and their partial sums merged
+template<typename Iterator>
+Binary sum(Iterator first, Iterator last, ThreadPool& pool) {
+    typedef BinaryAccumulator::size_type size_type;
+    const auto n = static_cast<size_type>(std::distance(first, last));
+    const size_type slices = std::min<size_type>(pool.size(), n / BinaryAccumulator::slice_values);
+    if (slices < 2) { return sum(first, last); }
+
+    std::vector<BinaryAccumulator> partial(slices);
+    ThreadPool::TaskGroup tasks(pool);
+    tasks.reserve(slices);
+    Iterator begin = first;
+    for (size_type s = 0; s < slices; ++s) {
+        const Iterator end = std::next(begin, n * (s + 1) / slices - n * s / slices);
+        BinaryAccumulator& accumulator = partial[s];
+        tasks.submit([&accumulator, begin, end] {
+            for (Iterator iter = begin; iter != end; ++iter) {
+                accumulator += *iter;
+            }
+        });
+        begin = end;
+    }
+    tasks.wait();
+
+    for (size_type s = 1; s < slices; ++s) {
+        partial[0] += partial[s];
+    }
+    return partial[0].value();
+}
+
+
+#endif //LMPA_LIBRARY_BINARYACCUMULATOR_H
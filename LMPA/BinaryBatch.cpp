@@ -0,0 +1,472 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "BinaryBatch.h"
+
+#include <stdexcept> // runtime_error, invalid_argument
+#include <string> // to_string
+
+using limb_type = BinaryBatch::limb_type;
+using size_type = BinaryBatch::size_type;
+using container_type = BinaryBatch::container_type;
+
+/**
+ * \brief Locally used functions and variables.
+ * The lane kernels process one block of BinaryBatch::lanes values per inner loop, which the compiler
+ * turns into one vector operation per limb.
+ */
+namespace {
+    constexpr size_type lanes = BinaryBatch::lanes;
+    constexpr size_type limb_bits = kernels::limb_bits;
+    constexpr limb_type low_mask = 0xFFFFFFFFull;
+
+    using kernels::limbs_for;
+
+    LMPA_TARGET_CLONES
+    void lanes_add(limb_type* __restrict r, const limb_type* __restrict a, const limb_type* __restrict b,
+                   size_type n, size_type stride) {
+        for (size_type i = 0; i < stride; i += lanes) {
+            limb_type carry[lanes] = {0};
+            for (size_type j = 0; j < n; ++j) {
+                const size_type offset = j * stride + i;
+                for (size_type k = 0; k < lanes; ++k) {
+                    limb_type s = a[offset + k] + carry[k];
+                    limb_type c = s < carry[k];
+                    limb_type t = s + b[offset + k];
+                    carry[k] = c + (t < s);
+                    r[offset + k] = t;
+                }
+            }
+        }
+    }
+
+    LMPA_TARGET_CLONES
+    void lanes_sub(limb_type* __restrict r, const limb_type* __restrict a, const limb_type* __restrict b,
+                   size_type n, size_type stride) {
+        for (size_type i = 0; i < stride; i += lanes) {
+            limb_type borrow[lanes] = {0};
+            for (size_type j = 0; j < n; ++j) {
+                const size_type offset = j * stride + i;
+                for (size_type k = 0; k < lanes; ++k) {
+                    limb_type s = b[offset + k] + borrow[k];
+                    limb_type c = s < borrow[k];
+                    limb_type d = a[offset + k] - s;
+                    borrow[k] = c + (d > a[offset + k]);
+                    r[offset + k] = d;
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief Lowest n limbs of the products. SIMD units only multiply 32 x 32 -> 64 bits, so the limbs are
+     * split into 32 bit digits. The low and high halves of every digit product are accumulated into separate
+     * columns, which cannot overflow for less than 2^31 digits, and the carries are propagated once at the end.
+     */
+    LMPA_TARGET_CLONES
+    void lanes_mul(limb_type* __restrict r, const limb_type* __restrict a, const limb_type* __restrict b,
+                   size_type n, size_type stride) {
+        const size_type m = 2 * n; // 32 bit digits per value
+        container_type da(m * lanes), db(m * lanes), acc(m * lanes);
+        for (size_type i = 0; i < stride; i += lanes) {
+            for (size_type j = 0; j < n; ++j) {
+                const size_type offset = j * stride + i;
+                for (size_type k = 0; k < lanes; ++k) {
+                    da[2 * j * lanes + k] = a[offset + k] & low_mask;
+                    da[(2 * j + 1) * lanes + k] = a[offset + k] >> 32;
+                    db[2 * j * lanes + k] = b[offset + k] & low_mask;
+                    db[(2 * j + 1) * lanes + k] = b[offset + k] >> 32;
+                }
+            }
+            std::fill(std::begin(acc), std::end(acc), 0);
+
+            for (size_type x = 0; x < m; ++x) {
+                for (size_type y = 0; x + y < m; ++y) {
+                    limb_type* col = acc.data() + (x + y) * lanes;
+                    const limb_type* pa = da.data() + x * lanes;
+                    const limb_type* pb = db.data() + y * lanes;
+                    if (x + y + 1 < m) {
+                        for (size_type k = 0; k < lanes; ++k) {
+                            limb_type p = pa[k] * pb[k];
+                            col[k] += p & low_mask;
+                            col[k + lanes] += p >> 32;
+                        }
+                    } else {
+                        for (size_type k = 0; k < lanes; ++k) {
+                            col[k] += (pa[k] * pb[k]) & low_mask;
+                        }
+                    }
+                }
+            }
+
+            // propagate the column carries and reassemble the limbs
+            limb_type carry[lanes] = {0};
+            for (size_type j = 0; j < n; ++j) {
+                const size_type offset = j * stride + i;
+                for (size_type k = 0; k < lanes; ++k) {
+                    limb_type lo = acc[2 * j * lanes + k] + carry[k];
+                    limb_type hi = acc[(2 * j + 1) * lanes + k] + (lo >> 32);
+                    carry[k] = hi >> 32;
+                    r[offset + k] = (lo & low_mask) | (hi << 32);
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief Compares from the highest limb down, the highest limb carrying the sign.
+     */
+    LMPA_TARGET_CLONES
+    void lanes_compare(int* __restrict result, const limb_type* __restrict a, const limb_type* __restrict b,
+                       size_type n, size_type stride) {
+        for (size_type i = 0; i < stride; i += lanes) {
+            int cmp[lanes];
+            const size_type top = (n - 1) * stride + i;
+            for (size_type k = 0; k < lanes; ++k) {
+                auto sa = static_cast<long long>(a[top + k]);
+                auto sb = static_cast<long long>(b[top + k]);
+                cmp[k] = (sa > sb) - (sa < sb);
+            }
+            for (size_type j = n - 1; j-- > 0;) {
+                const size_type offset = j * stride + i;
+                for (size_type k = 0; k < lanes; ++k) {
+                    int c = (a[offset + k] > b[offset + k]) - (a[offset + k] < b[offset + k]);
+                    cmp[k] = cmp[k] ? cmp[k] : c;
+                }
+            }
+            for (size_type k = 0; k < lanes; ++k) {
+                result[i + k] = cmp[k];
+            }
+        }
+    }
+
+    /**
+     * \brief Negates the values in the block (n limbs times lanes) whose mask is all ones.
+     */
+    inline void negate_masked(limb_type* v, const limb_type* mask, size_type n) {
+        limb_type carry[lanes];
+        for (size_type k = 0; k < lanes; ++k) {
+            carry[k] = mask[k] & 1;
+        }
+        for (size_type j = 0; j < n; ++j) {
+            for (size_type k = 0; k < lanes; ++k) {
+                limb_type x = (v[j * lanes + k] ^ mask[k]) + carry[k];
+                carry[k] = x < carry[k];
+                v[j * lanes + k] = x;
+            }
+        }
+    }
+
+    /**
+     * \brief Remainder of the truncated division, with the sign of the dividend.
+     * Restoring shift-and-subtract on the magnitudes, with the subtraction kept or discarded per lane by a mask.
+     */
+    LMPA_TARGET_CLONES
+    void lanes_mod(limb_type* __restrict r, const limb_type* __restrict a, const limb_type* __restrict b,
+                   size_type n, size_type stride, size_type bits) {
+        container_type ma(n * lanes), mb(n * lanes), rem(n * lanes), diff(n * lanes);
+        for (size_type i = 0; i < stride; i += lanes) {
+            limb_type sa[lanes], sb[lanes];
+            const size_type top = (n - 1) * stride + i;
+            for (size_type k = 0; k < lanes; ++k) {
+                sa[k] = 0 - (a[top + k] >> (limb_bits - 1));
+                sb[k] = 0 - (b[top + k] >> (limb_bits - 1));
+            }
+            for (size_type j = 0; j < n; ++j) {
+                for (size_type k = 0; k < lanes; ++k) {
+                    ma[j * lanes + k] = a[j * stride + i + k];
+                    mb[j * lanes + k] = b[j * stride + i + k];
+                    rem[j * lanes + k] = 0;
+                }
+            }
+            negate_masked(ma.data(), sa, n);
+            negate_masked(mb.data(), sb, n);
+
+            for (size_type bit = bits; bit-- > 0;) {
+                // rem = (rem << 1) | bit of a
+                const size_type word = bit / limb_bits, shift = bit % limb_bits;
+                for (size_type j = n; j-- > 1;) {
+                    for (size_type k = 0; k < lanes; ++k) {
+                        rem[j * lanes + k] = (rem[j * lanes + k] << 1) | (rem[(j - 1) * lanes + k] >> (limb_bits - 1));
+                    }
+                }
+                for (size_type k = 0; k < lanes; ++k) {
+                    rem[k] = (rem[k] << 1) | ((ma[word * lanes + k] >> shift) & 1);
+                }
+
+                // keep rem - b wherever it does not borrow
+                limb_type borrow[lanes] = {0};
+                for (size_type j = 0; j < n; ++j) {
+                    for (size_type k = 0; k < lanes; ++k) {
+                        limb_type s = mb[j * lanes + k] + borrow[k];
+                        limb_type c = s < borrow[k];
+                        limb_type d = rem[j * lanes + k] - s;
+                        borrow[k] = c + (d > rem[j * lanes + k]);
+                        diff[j * lanes + k] = d;
+                    }
+                }
+                for (size_type j = 0; j < n; ++j) {
+                    for (size_type k = 0; k < lanes; ++k) {
+                        limb_type keep = borrow[k] - 1; // all ones if there was no borrow
+                        rem[j * lanes + k] = (diff[j * lanes + k] & keep) | (rem[j * lanes + k] & ~keep);
+                    }
+                }
+            }
+
+            negate_masked(rem.data(), sa, n);
+            for (size_type j = 0; j < n; ++j) {
+                for (size_type k = 0; k < lanes; ++k) {
+                    r[j * stride + i + k] = rem[j * lanes + k];
+                }
+            }
+        }
+    }
+}
+
+
+/// Constructors ///
+
+/**
+ * \brief Default Constructor. Generates an empty batch of 32 bit precision.
+ */
+BinaryBatch::BinaryBatch() noexcept {
+}
+
+/**
+ * \brief Constructor with user-specified size and precision. All values will be 0.
+ * Throws std::invalid_argument for precision 0, which leaves no room for the sign.
+ */
+BinaryBatch::BinaryBatch(size_type count, size_type precision) noexcept(false) :
+        _size(count), _precision(precision), _limbs(limbs_for(precision)),
+        _stride((count + lanes - 1) / lanes * lanes) {
+    if (precision == 0) {
+        throw std::invalid_argument("BinaryBatch of precision 0.");
+    }
+    data.assign(_limbs * _stride, 0);
+}
+
+/**
+ * \brief Constructor from individual Binaries. The precision will be the maximum precision of the values.
+ */
+BinaryBatch::BinaryBatch(const std::vector<Binary>& values) : BinaryBatch(values.size(), 1) {
+    size_type prec = 1;
+    for (const auto& b : values) {
+        prec = std::max(prec, b.precision());
+    }
+    reserve(prec);
+    for (size_type i = 0; i < values.size(); ++i) {
+        set(i, values[i]);
+    }
+}
+
+
+/// Utility ///
+
+/**
+ * \brief Ensures the precision is at least prec without altering the values.
+ */
+void BinaryBatch::reserve(size_type prec) {
+    if (prec <= precision()) { return; }
+
+    const size_type n = limbs_for(prec);
+    if (n > _limbs) {
+        // the new limbs are filled with the sign of the previous highest limb
+        const size_type top = (_limbs - 1) * _stride;
+        data.resize(n * _stride);
+        for (size_type j = _limbs; j < n; ++j) {
+            for (size_type i = 0; i < _stride; ++i) {
+                data[j * _stride + i] = 0 - (data[top + i] >> (limb_bits - 1));
+            }
+        }
+        _limbs = n;
+    }
+    _precision = prec;
+}
+
+/**
+ * \brief Returns a copy of the i-th value.
+ */
+Binary BinaryBatch::get(size_type i) const {
+    Binary::limb_container limbs(_limbs);
+    for (size_type j = 0; j < _limbs; ++j) {
+        limbs[j] = data[j * _stride + i];
+    }
+    Binary result(precision());
+    result.assign_limbs(limbs, precision());
+    return result;
+}
+
+/**
+ * \brief Sets the i-th value. Will promote the batch to b's precision if necessary.
+ */
+void BinaryBatch::set(size_type i, const Binary& b) {
+    reserve(b.precision());
+    const Binary::limb_container limbs = b.to_limbs(_limbs);
+    for (size_type j = 0; j < _limbs; ++j) {
+        data[j * _stride + i] = limbs[j];
+    }
+}
+
+/**
+ * \brief Returns a copy promoted to the given precision.
+ */
+BinaryBatch BinaryBatch::promoted(size_type prec) const {
+    BinaryBatch result(*this);
+    result.reserve(prec);
+    return result;
+}
+
+/**
+ * \brief Returns copies of all values.
+ */
+std::vector<Binary> BinaryBatch::values() const {
+    std::vector<Binary> result;
+    result.reserve(size());
+    for (size_type i = 0; i < size(); ++i) {
+        result.emplace_back(get(i));
+    }
+    return result;
+}
+
+/**
+ * \brief Throws if b does not hold as many values as this.
+ */
+void BinaryBatch::check_size(const BinaryBatch& b) const noexcept(false) {
+    if (size() != b.size()) {
+        throw std::runtime_error("Elementwise operation on BinaryBatches of different sizes: "
+                                 + std::to_string(size()) + " and " + std::to_string(b.size()) + ".");
+    }
+}
+
+/**
+ * \brief Restores the invariant that the bits above the precision are copies of the sign bit.
+ */
+void BinaryBatch::sign_extend() {
+    const size_type used = precision() - (_limbs - 1) * limb_bits;
+    if (used == limb_bits) { return; }
+    const limb_type mask = (limb_type(1) << used) - 1;
+    limb_type* top = data.data() + (_limbs - 1) * _stride;
+    for (size_type i = 0; i < _stride; ++i) {
+        limb_type sgn = 0 - ((top[i] >> (used - 1)) & 1);
+        top[i] = (top[i] & mask) | (sgn & ~mask);
+    }
+}
+
+
+/// Assignment ///
+
+/**
+ * \brief Elementwise Addition Assignment Operator. Will promote the assigned-to object accordingly.
+ */
+BinaryBatch& BinaryBatch::operator+=(const BinaryBatch& b) noexcept(false) {
+    return *this = *this + b;
+}
+
+/**
+ * \brief Elementwise Subtraction Assignment Operator. Will promote the assigned-to object accordingly.
+ */
+BinaryBatch& BinaryBatch::operator-=(const BinaryBatch& b) noexcept(false) {
+    return *this = *this - b;
+}
+
+/**
+ * \brief Elementwise Multiplication Assignment Operator. Will promote the assigned-to object accordingly.
+ */
+BinaryBatch& BinaryBatch::operator*=(const BinaryBatch& b) noexcept(false) {
+    return *this = *this * b;
+}
+
+/**
+ * \brief Elementwise Modulo Assignment Operator. Will promote the assigned-to object accordingly.
+ */
+BinaryBatch& BinaryBatch::operator%=(const BinaryBatch& b) noexcept(false) {
+    return *this = *this % b;
+}
+
+
+/// Arithmetic ///
+
+/**
+ * \brief Elementwise Addition Operator. The result will be of the maximum precision of the two arguments.
+ */
+BinaryBatch BinaryBatch::operator+(const BinaryBatch& b) const noexcept(false) {
+    check_size(b);
+    if (precision() < b.precision()) { return promoted(b.precision()) + b; }
+    if (b.precision() < precision()) { return *this + b.promoted(precision()); }
+
+    BinaryBatch result(size(), precision());
+    lanes_add(result.data.data(), data.data(), b.data.data(), _limbs, _stride);
+    result.sign_extend();
+    return result;
+}
+
+/**
+ * \brief Elementwise Subtraction Operator. The result will be of the maximum precision of the two arguments.
+ */
+BinaryBatch BinaryBatch::operator-(const BinaryBatch& b) const noexcept(false) {
+    check_size(b);
+    if (precision() < b.precision()) { return promoted(b.precision()) - b; }
+    if (b.precision() < precision()) { return *this - b.promoted(precision()); }
+
+    BinaryBatch result(size(), precision());
+    lanes_sub(result.data.data(), data.data(), b.data.data(), _limbs, _stride);
+    result.sign_extend();
+    return result;
+}
+
+/**
+ * \brief Elementwise Multiplication Operator. The result will be of the maximum precision of the two arguments.
+ */
+BinaryBatch BinaryBatch::operator*(const BinaryBatch& b) const noexcept(false) {
+    check_size(b);
+    if (precision() < b.precision()) { return promoted(b.precision()) * b; }
+    if (b.precision() < precision()) { return *this * b.promoted(precision()); }
+
+    BinaryBatch result(size(), precision());
+    lanes_mul(result.data.data(), data.data(), b.data.data(), _limbs, _stride);
+    result.sign_extend();
+    return result;
+}
+
+/**
+ * \brief Elementwise Modulo Operator. The result will be of the maximum precision of the two arguments.
+ * May throw if any divisor has a value of 0.
+ */
+BinaryBatch BinaryBatch::operator%(const BinaryBatch& b) const noexcept(false) {
+    check_size(b);
+    if (precision() < b.precision()) { return promoted(b.precision()) % b; }
+    if (b.precision() < precision()) { return *this % b.promoted(precision()); }
+
+    for (size_type i = 0; i < size(); ++i) {
+        bool zero = true;
+        for (size_type j = 0; j < _limbs && zero; ++j) {
+            zero = b.data[j * _stride + i] == 0;
+        }
+        if (zero) {
+            throw div_by_zero_error("BinaryBatch divisor at index " + std::to_string(i) + " is zero.");
+        }
+    }
+
+    BinaryBatch result(size(), precision());
+    lanes_mod(result.data.data(), data.data(), b.data.data(), _limbs, _stride, precision());
+    result.sign_extend();
+    return result;
+}
+
+
+/// Comparison ///
+
+/**
+ * \brief Elementwise comparison. The values are compared at the maximum precision of the two arguments.
+ */
+std::vector<int> BinaryBatch::compare(const BinaryBatch& b) const noexcept(false) {
+    check_size(b);
+    if (precision() < b.precision()) { return promoted(b.precision()).compare(b); }
+    if (b.precision() < precision()) { return compare(b.promoted(precision())); }
+
+    std::vector<int> result(_stride);
+    lanes_compare(result.data(), data.data(), b.data.data(), _limbs, _stride);
+    result.resize(size());
+    return result;
+}
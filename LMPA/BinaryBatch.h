@@ -0,0 +1,81 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_BINARYBATCH_H
+#define LMPA_LIBRARY_BINARYBATCH_H
+
+#include <vector> // container, size_t
+
+#include "Binary.h"
+#include "Kernels.h"
+
+/**
+ * \brief Many Binaries of equal precision, stored as structure of arrays:
+ * limb j of every value is contiguous, so that the elementwise operations run over several values at once.
+ */
+class BinaryBatch {
+public:
+    typedef kernels::limb_type                      limb_type;
+    typedef std::size_t                             size_type;
+    typedef kernels::container_type                 container_type;
+
+    // values processed together by the elementwise kernels, enough for AVX-512
+    static constexpr size_type lanes = 8;
+
+
+    /// Constructors ///
+    BinaryBatch() noexcept;
+    // throws std::invalid_argument if precision is 0
+    explicit BinaryBatch(size_type count, size_type precision = 32) noexcept(false);
+    explicit BinaryBatch(const std::vector<Binary>& values);
+
+    BinaryBatch(const BinaryBatch& b) = default;
+    BinaryBatch(BinaryBatch&& b) = default;
+
+    ~BinaryBatch() = default;
+
+
+    /// Utility ///
+    inline size_type size() const { return _size; }
+    inline size_type precision() const { return _precision; }
+    void reserve(size_type prec);
+    Binary get(size_type i) const;
+    void set(size_type i, const Binary& b);
+    std::vector<Binary> values() const;
+
+
+    /// Assignment ///
+    // all assignment operators may safely promote the assigned-to object's precision
+    BinaryBatch& operator=(const BinaryBatch& b) = default;
+    BinaryBatch& operator=(BinaryBatch&& b) = default;
+    BinaryBatch& operator+=(const BinaryBatch& b) noexcept(false);
+    BinaryBatch& operator-=(const BinaryBatch& b) noexcept(false);
+    BinaryBatch& operator*=(const BinaryBatch& b) noexcept(false);
+    BinaryBatch& operator%=(const BinaryBatch& b) noexcept(false);
+
+    /// Arithmetic ///
+    BinaryBatch operator+(const BinaryBatch& b) const noexcept(false);
+    BinaryBatch operator-(const BinaryBatch& b) const noexcept(false);
+    BinaryBatch operator*(const BinaryBatch& b) const noexcept(false);
+    BinaryBatch operator%(const BinaryBatch& b) const noexcept(false);
+
+    /// Comparison ///
+    // elementwise -1, 0 or 1 if the value is less than, equal to or greater than the one in b
+    std::vector<int> compare(const BinaryBatch& b) const noexcept(false);
+
+private:
+    size_type _size = 0;
+    size_type _precision = 32; // bits, including the sign
+    size_type _limbs = 1; // limbs per value
+    size_type _stride = 0; // _size rounded up to a multiple of lanes
+    container_type data; // limb j of value i is at data[j * _stride + i]
+
+    void check_size(const BinaryBatch& b) const noexcept(false);
+    BinaryBatch promoted(size_type prec) const;
+    void sign_extend();
+
+};
+
+
+#endif //LMPA_LIBRARY_BINARYBATCH_H
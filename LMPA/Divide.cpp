@@ -0,0 +1,165 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Kernels.h"
+
+#include <vector> // normalized operands
+
+using kernels::limb_type;
+using kernels::size_type;
+using kernels::container_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    constexpr limb_type half_base = limb_type(1) << 32;
+    constexpr limb_type half_mask = half_base - 1;
+
+    inline unsigned clz(limb_type x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_clzll(x));
+#else
+        unsigned n = 0;
+        for (limb_type bit = limb_type(1) << 63; !(x & bit); bit >>= 1) { ++n; }
+        return n;
+#endif // builtin check
+    }
+
+    /**
+     * \brief Divides the two-limb number (u1, u0) by v, requires u1 < v. Returns the quotient, sets the remainder.
+     * Works on 32 bit halves (Hacker's Delight, divlu), so that no 128 bit division is required.
+     */
+    limb_type div_ll(limb_type u1, limb_type u0, limb_type v, limb_type& rem) {
+        const unsigned s = clz(v);
+        v <<= s;
+        const limb_type vn1 = v >> 32;
+        const limb_type vn0 = v & half_mask;
+
+        const limb_type un32 = s ? (u1 << s) | (u0 >> (64 - s)) : u1;
+        const limb_type un10 = u0 << s;
+        const limb_type un1 = un10 >> 32;
+        const limb_type un0 = un10 & half_mask;
+
+        limb_type q1 = un32 / vn1;
+        limb_type rhat = un32 - q1 * vn1;
+        while (q1 >= half_base || q1 * vn0 > (rhat << 32) + un1) {
+            --q1;
+            rhat += vn1;
+            if (rhat >= half_base) { break; }
+        }
+
+        const limb_type un21 = (un32 << 32) + un1 - q1 * v;
+        limb_type q0 = un21 / vn1;
+        rhat = un21 - q0 * vn1;
+        while (q0 >= half_base || q0 * vn0 > (rhat << 32) + un0) {
+            --q0;
+            rhat += vn1;
+            if (rhat >= half_base) { break; }
+        }
+
+        rem = ((un21 << 32) + un0 - q0 * v) >> s;
+        return (q1 << 32) + q0;
+    }
+
+}
+
+
+/// Shifts ///
+
+limb_type kernels::lshift(limb_type* r, const limb_type* a, size_type n, unsigned s) {
+    limb_type out = 0;
+    for (size_type i = 0; i < n; ++i) {
+        const limb_type x = a[i];
+        r[i] = (x << s) | out;
+        out = x >> (limb_bits - s);
+    }
+    return out;
+}
+
+limb_type kernels::rshift(limb_type* r, const limb_type* a, size_type n, unsigned s) {
+    limb_type out = 0;
+    for (size_type i = n; i-- > 0;) {
+        const limb_type x = a[i];
+        r[i] = (x >> s) | out;
+        out = x << (limb_bits - s);
+    }
+    return out;
+}
+
+
+/// Division ///
+
+/**
+ * \brief Schoolbook division by a single limb, from the highest limb down.
+ */
+limb_type kernels::divrem_1(limb_type* q, const limb_type* a, size_type n, limb_type d) {
+    limb_type rem = 0;
+    for (size_type i = n; i-- > 0;) {
+        q[i] = div_ll(rem, a[i], d, rem);
+    }
+    return rem;
+}
+
+/**
+ * \brief Schoolbook long division (Knuth, TAOCP Vol. 2, 4.3.1, Algorithm D).
+ * The divisor is normalized so that its highest bit is set, which makes every estimated quotient limb
+ * at most two too large.
+ */
+void kernels::divrem(limb_type* q, limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn) {
+    if (bn == 1) {
+        r[0] = divrem_1(q, a, an, b[0]);
+        return;
+    }
+
+    const unsigned s = clz(b[bn - 1]);
+    container_type vn(b, b + bn);
+    container_type un(a, a + an);
+    un.emplace_back(0);
+    if (s) {
+        lshift(vn.data(), vn.data(), bn, s);
+        un[an] = lshift(un.data(), un.data(), an, s);
+    }
+
+    const limb_type v1 = vn[bn - 1];
+    const limb_type v2 = vn[bn - 2];
+    container_type prod(bn + 1);
+
+    for (size_type j = an - bn + 1; j-- > 0;) {
+        // estimate the quotient limb from the two highest limbs, then correct it with the third
+        limb_type qhat, rhat;
+        bool rhat_overflow = false;
+        if (un[j + bn] >= v1) {
+            qhat = ~limb_type(0);
+            rhat = un[j + bn - 1] + v1; // un[j + bn] == v1 here
+            rhat_overflow = rhat < v1;
+        } else {
+            qhat = div_ll(un[j + bn], un[j + bn - 1], v1, rhat);
+        }
+        while (!rhat_overflow) {
+            // qhat * v2 > rhat * B + un[j + bn - 2] means qhat is too large
+            limb_type plo;
+            const limb_type phi = mul_1(&plo, &v2, 1, qhat);
+            if (phi < rhat || (phi == rhat && plo <= un[j + bn - 2])) { break; }
+            --qhat;
+            rhat += v1;
+            rhat_overflow = rhat < v1;
+        }
+
+        prod[bn] = mul_1(prod.data(), vn.data(), bn, qhat);
+        if (sub_n(un.data() + j, un.data() + j, prod.data(), bn + 1)) {
+            // the estimate was still one too large, add the divisor back
+            --qhat;
+            un[j + bn] += add_n(un.data() + j, un.data() + j, vn.data(), bn);
+        }
+        q[j] = qhat;
+    }
+
+    if (s) {
+        rshift(r, un.data(), bn, s);
+        r[bn - 1] |= un[bn] << (limb_bits - s);
+    } else {
+        for (size_type i = 0; i < bn; ++i) { r[i] = un[i]; }
+    }
+}
@@ -0,0 +1,55 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "DivisorU64.h"
+
+using kernels::limb_type;
+using kernels::size_type;
+
+
+/// Constructors ///
+
+/**
+ * \brief Normalizes the divisor and computes its reciprocal with the only division ever needed:
+ * (2^128 - 1 - normalized * 2^64) / normalized, whose high limb ~normalized is below the divisor.
+ */
+DivisorU64::DivisorU64(limb_type divisor) noexcept(false) : d(divisor), shift(0) {
+    if (d == 0) {
+        throw div_by_zero_error();
+    }
+    while (!((d << shift) >> (kernels::limb_bits - 1))) { ++shift; }
+    normalized = d << shift;
+
+    const limb_type numerator[2] = {~limb_type(0), ~normalized};
+    limb_type quotient[2];
+    kernels::divrem_1(quotient, numerator, 2, normalized);
+    reciprocal = quotient[0];
+}
+
+
+/// Division ///
+
+/**
+ * \brief Divides the dividend shifted by the divisor's leading zeros by the normalized divisor, from the highest limb
+ * down. The quotient is the same, the remainder is shifted back.
+ */
+limb_type DivisorU64::divrem(limb_type* q, const limb_type* a, size_type n) const {
+    if (n == 0) { return 0; }
+    limb_type r = shift ? a[n - 1] >> (kernels::limb_bits - shift) : 0;
+    for (size_type i = n; i-- > 0;) {
+        const limb_type u0 = shift ? (a[i] << shift) | (i ? a[i - 1] >> (kernels::limb_bits - shift) : 0) : a[i];
+        q[i] = step(r, u0, r);
+    }
+    return r >> shift;
+}
+
+limb_type DivisorU64::mod(const limb_type* a, size_type n) const {
+    if (n == 0) { return 0; }
+    limb_type r = shift ? a[n - 1] >> (kernels::limb_bits - shift) : 0;
+    for (size_type i = n; i-- > 0;) {
+        const limb_type u0 = shift ? (a[i] << shift) | (i ? a[i - 1] >> (kernels::limb_bits - shift) : 0) : a[i];
+        step(r, u0, r);
+    }
+    return r >> shift;
+}
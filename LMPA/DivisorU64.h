@@ -0,0 +1,69 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_DIVISORU64_H
+#define LMPA_LIBRARY_DIVISORU64_H
+
+#include "Binary.h"
+
+/**
+ * \brief A single-limb divisor with a precomputed reciprocal (Möller and Granlund, Improved division by invariant
+ * integers, 2011). Every quotient limb then costs two multiplications and a few additions instead of a division,
+ * which pays off as soon as the same divisor divides more than a few limbs.
+ */
+class DivisorU64 {
+public:
+    typedef kernels::limb_type                      limb_type;
+    typedef kernels::size_type                      size_type;
+
+    /// Constructors ///
+    // throws div_by_zero_error if d is 0
+    explicit DivisorU64(limb_type d) noexcept(false);
+
+    /// Utility ///
+    inline limb_type value() const { return d; }
+
+    /// Division ///
+    // q = a / d on n limbs, returns a % d. q may equal a
+    limb_type divrem(limb_type* q, const limb_type* a, size_type n) const;
+    // a % d on n limbs
+    limb_type mod(const limb_type* a, size_type n) const;
+    // (hi * 2^64 + lo) % d for hi < d, e.g. for the product of two remainders
+    inline limb_type mod(limb_type hi, limb_type lo) const {
+        limb_type r;
+        step(shift ? (hi << shift) | (lo >> (kernels::limb_bits - shift)) : hi, lo << shift, r);
+        return r >> shift;
+    }
+
+private:
+    limb_type d;
+    unsigned shift; // leading zeros of d
+    limb_type normalized; // d << shift
+    limb_type reciprocal; // floor((2^128 - 1) / normalized) - 2^64
+
+    /**
+     * \brief Divides (u1, u0) by the normalized divisor for u1 < normalized. Returns the quotient, sets the remainder.
+     * The quotient estimated from the reciprocal is at most one too small or one too large.
+     */
+    inline limb_type step(limb_type u1, limb_type u0, limb_type& r) const {
+        limb_type q1;
+        limb_type q0 = kernels::mul_ll(reciprocal, u1, q1);
+        q0 += u0;
+        q1 += u1 + 1 + (q0 < u0);
+        r = u0 - q1 * normalized;
+        if (r > q0) {
+            --q1;
+            r += normalized;
+        }
+        if (r >= normalized) {
+            ++q1;
+            r -= normalized;
+        }
+        return q1;
+    }
+
+};
+
+
+#endif //LMPA_LIBRARY_DIVISORU64_H
@@ -0,0 +1,149 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_FIXEDPOINT_H
+#define LMPA_LIBRARY_FIXEDPOINT_H
+
+#include <algorithm> // max
+#include <iostream> // operator<< stream overload
+
+#include "Binary.h"
+#include "LMPA.h"
+#include "Natural.h"
+
+/**
+ * \brief Fixed point number with IntBits bits before the radix point (including the sign) and FracBits after it.
+ * The value is a single Binary of IntBits + FracBits bits holding value * 2^FracBits, so that addition,
+ * subtraction and comparison are plain Binary operations, while multiplication and division need a single shift.
+ * Like Binary, all operations wrap at the precision. Multiplication and division truncate toward zero.
+ */
+template<Binary::size_type IntBits, Binary::size_type FracBits>
+class FixedPoint {
+    static_assert(IntBits > 0, "FixedPoint requires at least the sign bit before the radix point!");
+
+public:
+    typedef Binary::size_type                       size_type;
+
+    static constexpr size_type precision = IntBits + FracBits;
+
+
+    /// Constructors ///
+    FixedPoint() noexcept : raw_value(precision) {}
+
+    /**
+     * \brief Constructor from an integer.
+     */
+    explicit FixedPoint(const Binary& b) : raw_value(precision) {
+        Binary scaled = b;
+        scaled.reserve(precision);
+        scaled.set_precision(precision);
+        raw_value = scaled << FracBits;
+        raw_value.set_precision(precision);
+    }
+
+    /**
+     * \brief Constructor from a double, truncated toward zero to the fractional bits. The double is scaled
+     * exactly as an LMPA, so that no fractional bits overflow it.
+     */
+    explicit FixedPoint(double d) noexcept(false) : raw_value(LMPA::from_double(d).ldexp(FracBits).to_binary()) {
+        raw_value.reserve(precision);
+        raw_value.set_precision(precision);
+    }
+
+    /**
+     * \brief Constructor from the raw representation value * 2^FracBits.
+     */
+    static FixedPoint from_raw(const Binary& raw) {
+        FixedPoint result;
+        result.raw_value = raw;
+        result.raw_value.set_precision(precision);
+        return result;
+    }
+
+    FixedPoint(const FixedPoint& f) = default;
+    FixedPoint(FixedPoint&& f) = default;
+
+    ~FixedPoint() = default;
+
+
+    /// Utility ///
+    inline const Binary& raw() const { return raw_value; }
+    inline bool sign() const { return raw_value.sign(); }
+
+    /**
+     * \brief Returns the integer part, truncated toward zero.
+     */
+    Binary to_binary() const {
+        return Binary::from_magnitude(natural::shr(raw_value.magnitude(), FracBits), sign());
+    }
+
+    double to_double() const {
+        return LMPA(raw_value, 53).ldexp(-static_cast<LMPA::exponent_type>(FracBits)).to_double();
+    }
+
+
+    /// Assignment ///
+    FixedPoint& operator=(const FixedPoint& f) = default;
+    FixedPoint& operator=(FixedPoint&& f) = default;
+    FixedPoint& operator+=(const FixedPoint& f) { raw_value += f.raw_value; return *this; }
+    FixedPoint& operator-=(const FixedPoint& f) { raw_value -= f.raw_value; return *this; }
+    FixedPoint& operator*=(const FixedPoint& f) { return *this = *this * f; }
+    FixedPoint& operator/=(const FixedPoint& f) noexcept(false) { return *this = *this / f; }
+
+    /// Arithmetic ///
+    FixedPoint operator+() const { return *this; }
+    FixedPoint operator-() const { return from_raw(-raw_value); }
+
+    FixedPoint operator+(const FixedPoint& f) const { return from_raw(raw_value + f.raw_value); }
+    FixedPoint operator-(const FixedPoint& f) const { return from_raw(raw_value - f.raw_value); }
+
+    /**
+     * \brief Multiplication Operator. The double width product is shifted back by FracBits once.
+     */
+    FixedPoint operator*(const FixedPoint& f) const {
+        const natural::container_type product = natural::mul(raw_value.magnitude(), f.raw_value.magnitude());
+        return from_raw(Binary::from_magnitude(natural::shr(product, FracBits), sign() != f.sign()));
+    }
+
+    /**
+     * \brief Division Operator. The dividend is shifted by FracBits once before the integer division.
+     * May throw if the divisor has a value of 0.
+     */
+    FixedPoint operator/(const FixedPoint& f) const noexcept(false) {
+        natural::container_type q, r;
+        natural::divrem(natural::shl(raw_value.magnitude(), FracBits), f.raw_value.magnitude(), q, r);
+        return from_raw(Binary::from_magnitude(q, sign() != f.sign()));
+    }
+
+    /// Comparison ///
+    bool operator==(const FixedPoint& f) const { return raw_value == f.raw_value; }
+    bool operator!=(const FixedPoint& f) const { return raw_value != f.raw_value; }
+    bool operator<(const FixedPoint& f) const { return raw_value < f.raw_value; }
+    bool operator>(const FixedPoint& f) const { return raw_value > f.raw_value; }
+    bool operator<=(const FixedPoint& f) const { return raw_value <= f.raw_value; }
+    bool operator>=(const FixedPoint& f) const { return raw_value >= f.raw_value; }
+
+
+    /**
+     * \brief Stream Output Operator. Prints the signed binary value with its radix point, e.g. -0b101.011
+     */
+    friend std::ostream& operator<<(std::ostream& stream, const FixedPoint& f) {
+        const natural::container_type magnitude = f.raw_value.magnitude();
+        if (f.sign()) { stream << "-"; }
+        stream << "0b";
+        // at least one digit before the radix point
+        for (size_type i = std::max(natural::bit_length(magnitude), FracBits + 1); i-- > 0;) {
+            if (i + 1 == FracBits) { stream << "."; }
+            stream << natural::bit(magnitude, i);
+        }
+        return stream;
+    }
+
+private:
+    Binary raw_value;
+
+};
+
+
+#endif //LMPA_LIBRARY_FIXEDPOINT_H
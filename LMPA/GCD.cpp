@@ -0,0 +1,283 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "GCD.h"
+#include "Natural.h"
+
+#include <cstdint> // int64_t
+
+using kernels::limb_type;
+typedef Binary::limb_container limb_container;
+typedef Binary::size_type size_type;
+
+/**
+ * \brief Locally used functions and variables.
+ * Values are unsigned little-endian limbs without leading zero limbs, an empty container being 0.
+ */
+namespace {
+    // leading bits used by a Lehmer step, small enough for the cofactor arithmetic not to overflow int64
+    constexpr size_type lehmer_bits = 61;
+
+    inline unsigned ctz(limb_type x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+        unsigned n = 0;
+        for (; !(x & 1); x >>= 1) { ++n; }
+        return n;
+#endif // builtin check
+    }
+
+    /**
+     * \brief Binary GCD of single limbs: strips the common factors of two, then subtracts the smaller odd value
+     * from the larger one and strips the factors of two of the difference, without any division.
+     */
+    limb_type gcd_1(limb_type a, limb_type b) {
+        if (a == 0) { return b; }
+        if (b == 0) { return a; }
+        const unsigned shift = ctz(a | b);
+        a >>= ctz(a);
+        do {
+            b >>= ctz(b);
+            if (a > b) { std::swap(a, b); }
+            b -= a;
+        } while (b);
+        return a << shift;
+    }
+
+    /**
+     * \brief 64 bits of a starting at bit shift.
+     */
+    limb_type bits_at(const limb_container& a, size_type shift) {
+        const size_type i = shift / kernels::limb_bits;
+        const unsigned offset = static_cast<unsigned>(shift % kernels::limb_bits);
+        if (i >= a.size()) { return 0; }
+        limb_type result = a[i] >> offset;
+        if (offset && i + 1 < a.size()) {
+            result |= a[i + 1] << (kernels::limb_bits - offset);
+        }
+        return result;
+    }
+
+    /**
+     * \brief Cofactors of a Lehmer step: the quotients of Euclid's algorithm on the leading bits of a and b,
+     * as long as they are guaranteed to be those of a and b (Knuth, Algorithm L).
+     * Then (a, b) becomes (A * a + B * b, C * a + D * b). B is 0 if not even one quotient is certain.
+     */
+    struct Cofactors {
+        std::int64_t A = 1, B = 0, C = 0, D = 1;
+    };
+
+    Cofactors lehmer(const limb_container& a, const limb_container& b) {
+        const size_type bits = natural::bit_length(a);
+        const size_type shift = bits > lehmer_bits ? bits - lehmer_bits : 0;
+        auto ah = static_cast<std::int64_t>(bits_at(a, shift) & ((limb_type(1) << lehmer_bits) - 1));
+        auto bh = static_cast<std::int64_t>(bits_at(b, shift) & ((limb_type(1) << lehmer_bits) - 1));
+
+        Cofactors f;
+        while (bh + f.C != 0 && bh + f.D != 0) {
+            const std::int64_t q = (ah + f.A) / (bh + f.C);
+            if (q != (ah + f.B) / (bh + f.D)) { break; }
+            std::int64_t t = f.A - q * f.C;
+            f.A = f.C;
+            f.C = t;
+            t = f.B - q * f.D;
+            f.B = f.D;
+            f.D = t;
+            t = ah - q * bh;
+            ah = bh;
+            bh = t;
+        }
+        return f;
+    }
+
+    /**
+     * \brief x * a + y * b for cofactors x and y of opposite signs, where the result is known to be nonnegative.
+     */
+    limb_container combine(std::int64_t x, const limb_container& a, std::int64_t y, const limb_container& b) {
+        const limb_container xa = natural::mul(a, natural::from_limb(static_cast<limb_type>(x < 0 ? -x : x)));
+        const limb_container yb = natural::mul(b, natural::from_limb(static_cast<limb_type>(y < 0 ? -y : y)));
+        return y <= 0 ? natural::sub(xa, yb) : natural::sub(yb, xa);
+    }
+
+    /**
+     * \brief A signed value as magnitude and sign, for the cofactors of the extended GCD.
+     */
+    struct Signed {
+        limb_container magnitude;
+        bool negative;
+
+        Signed(const limb_container& m = limb_container(), bool neg = false) : magnitude(m), negative(neg) {}
+    };
+
+    Signed add(const Signed& x, const Signed& y) {
+        Signed result;
+        if (x.negative == y.negative) {
+            result.magnitude = natural::add(x.magnitude, y.magnitude);
+            result.negative = x.negative;
+        } else if (natural::compare(x.magnitude, y.magnitude) >= 0) {
+            result.magnitude = natural::sub(x.magnitude, y.magnitude);
+            result.negative = x.negative;
+        } else {
+            result.magnitude = natural::sub(y.magnitude, x.magnitude);
+            result.negative = y.negative;
+        }
+        result.negative = result.negative && !result.magnitude.empty();
+        return result;
+    }
+
+    Signed scale(const Signed& x, std::int64_t f) {
+        Signed result;
+        result.magnitude = natural::mul(x.magnitude, natural::from_limb(static_cast<limb_type>(f < 0 ? -f : f)));
+        result.negative = (x.negative != (f < 0)) && !result.magnitude.empty();
+        return result;
+    }
+
+    /**
+     * \brief gcd of a >= b. Lehmer steps reduce both values by about lehmer_bits bits for the price of
+     * four multiplications by a limb, until b fits into a limb and the binary GCD takes over.
+     * Where the leading bits do not determine a quotient, a full division step is done instead.
+     */
+    limb_container gcd_of(limb_container a, limb_container b) {
+        while (b.size() > 1) {
+            const Cofactors f = lehmer(a, b);
+            if (f.B == 0) {
+                limb_container q, r;
+                natural::divrem(a, b, q, r);
+                a = std::move(b);
+                b = std::move(r);
+            } else {
+                limb_container na = combine(f.A, a, f.B, b);
+                b = combine(f.C, a, f.D, b);
+                a = std::move(na);
+            }
+        }
+        if (b.empty()) { return a; }
+
+        limb_container q(a.size());
+        const limb_type r = kernels::divrem_1(q.data(), a.data(), a.size(), b[0]);
+        return natural::from_limb(gcd_1(b[0], r));
+    }
+
+    /**
+     * \brief gcd of a >= b and the cofactor s with g = s * a + t * b, by the same steps as gcd_of.
+     * The cofactors of a and b relative to the original a are updated with the same matrices,
+     * down to single limbs where Euclid's algorithm finishes.
+     */
+    limb_container gcdext_of(limb_container a, limb_container b, Signed& s) {
+        Signed sa(natural::from_limb(1)), sb;
+        while (!b.empty()) {
+            const Cofactors f = b.size() > 1 ? lehmer(a, b) : Cofactors();
+            if (f.B == 0) {
+                limb_container q, r;
+                natural::divrem(a, b, q, r);
+                a = std::move(b);
+                b = std::move(r);
+                Signed qsb;
+                qsb.magnitude = natural::mul(q, sb.magnitude);
+                qsb.negative = !sb.negative && !qsb.magnitude.empty();
+                Signed next = add(sa, qsb);
+                sa = std::move(sb);
+                sb = std::move(next);
+            } else {
+                limb_container na = combine(f.A, a, f.B, b);
+                b = combine(f.C, a, f.D, b);
+                a = std::move(na);
+                Signed nsa = add(scale(sa, f.A), scale(sb, f.B));
+                sb = add(scale(sa, f.C), scale(sb, f.D));
+                sa = std::move(nsa);
+            }
+        }
+        s = std::move(sa);
+        return a;
+    }
+
+    Binary result_of(const limb_container& magnitude, bool negative, const Binary& a, const Binary& b) {
+        return Binary::from_magnitude(magnitude, negative, std::max(a.precision(), b.precision()));
+    }
+}
+
+
+/// Greatest Common Divisor ///
+
+/**
+ * \brief Greatest common divisor by Lehmer's algorithm, finished by the binary GCD on single limbs.
+ */
+Binary gcd(const Binary& a, const Binary& b) {
+    limb_container x = a.magnitude(), y = b.magnitude();
+    if (natural::compare(x, y) < 0) { std::swap(x, y); }
+    return result_of(gcd_of(std::move(x), std::move(y)), false, a, b);
+}
+
+/**
+ * \brief Least common multiple |a| / gcd(a, b) * |b|.
+ */
+Binary lcm(const Binary& a, const Binary& b) {
+    limb_container x = a.magnitude(), y = b.magnitude();
+    if (x.empty() || y.empty()) { return result_of(limb_container(), false, a, b); }
+
+    const limb_container g = natural::compare(x, y) < 0 ? gcd_of(y, x) : gcd_of(x, y);
+    return result_of(natural::mul(natural::divexact(x, g), y), false, a, b);
+}
+
+/**
+ * \brief Extended greatest common divisor: g = gcd(a, b) = s * a + t * b. Only s is tracked through
+ * the Lehmer steps, t = (g - s * a) / b is an exact division at the end.
+ */
+void gcdext(const Binary& a, const Binary& b, Binary& g, Binary& s, Binary& t) {
+    limb_container x = a.magnitude(), y = b.magnitude();
+    const bool swapped = natural::compare(x, y) < 0;
+    if (swapped) { std::swap(x, y); }
+
+    Signed sx;
+    const limb_container divisor = gcdext_of(x, y, sx);
+
+    // the cofactor of y from g = sx * x + sy * y
+    Signed sy;
+    if (!y.empty()) {
+        Signed product;
+        product.magnitude = natural::mul(sx.magnitude, x);
+        product.negative = !sx.negative && !product.magnitude.empty();
+        Signed difference = add({divisor, false}, product);
+        sy.magnitude = natural::divexact(difference.magnitude, y);
+        sy.negative = difference.negative && !sy.magnitude.empty();
+    }
+
+    if (swapped) { std::swap(sx, sy); }
+    // the cofactors of the magnitudes change sign with the arguments
+    g = result_of(divisor, false, a, b);
+    s = result_of(sx.magnitude, sx.negative != a.sign(), a, b);
+    t = result_of(sy.magnitude, sy.negative != b.sign(), a, b);
+}
+
+/**
+ * \brief Modular inverse from the extended GCD of a modulo m and m. Returns false if gcd(a, m) is not 1.
+ * Throws div_by_zero_error if m is 0.
+ */
+bool invert(Binary& result, const Binary& a, const Binary& m) noexcept(false) {
+    const limb_container modulus = m.magnitude();
+    limb_container q, r;
+    natural::divrem(a.magnitude(), modulus, q, r);
+    if (a.sign() && !r.empty()) { r = natural::sub(modulus, r); }
+    if (modulus == natural::from_limb(1)) {
+        // every value is 0 and its own inverse
+        result = result_of(limb_container(), false, a, m);
+        return true;
+    }
+
+    Signed s;
+    const limb_container divisor = gcdext_of(modulus, r, s);
+    if (divisor != natural::from_limb(1)) { return false; }
+
+    // 1 = s * m + t * r, so t = (1 - s * m) / r is the inverse of r
+    Signed product;
+    product.magnitude = natural::mul(s.magnitude, modulus);
+    product.negative = !s.negative && !product.magnitude.empty();
+    const Signed difference = add({natural::from_limb(1), false}, product);
+    limb_container t = natural::divexact(difference.magnitude, r);
+    if (difference.negative && !t.empty()) { t = natural::sub(modulus, t); }
+
+    result = result_of(t, false, a, m);
+    return true;
+}
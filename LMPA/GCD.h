@@ -0,0 +1,23 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_GCD_H
+#define LMPA_LIBRARY_GCD_H
+
+#include "Binary.h"
+
+/// Greatest Common Divisor ///
+// results have the smallest precision holding them, but at least the larger precision of the arguments
+
+// nonnegative, gcd(0, 0) is 0
+Binary gcd(const Binary& a, const Binary& b);
+// nonnegative, 0 if either argument is 0
+Binary lcm(const Binary& a, const Binary& b);
+// g = gcd(a, b) = s * a + t * b
+void gcdext(const Binary& a, const Binary& b, Binary& g, Binary& s, Binary& t);
+// result = a^-1 modulo |m| in [0, |m|), returns false if a is not invertible. Throws div_by_zero_error if m is 0
+bool invert(Binary& result, const Binary& a, const Binary& m) noexcept(false);
+
+
+#endif //LMPA_LIBRARY_GCD_H
@@ -0,0 +1,103 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Instrumentation.h"
+
+#ifdef LMPA_INSTRUMENTATION
+#include <atomic> // counters
+#include <chrono> // wall time
+#endif // LMPA_INSTRUMENTATION
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    constexpr const char* names[] = {
+            "assign", "add", "subtract", "multiply", "divide", "modulo", "shift_left", "shift_right",
+            "increment", "decrement", "negate", "absval", "compare", "print"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == instrumentation::operation_count, "Every operation needs a name.");
+
+#ifdef LMPA_INSTRUMENTATION
+    struct AtomicCounters {
+        std::atomic<std::uint64_t> calls{0}, operand_bits{0}, nanoseconds{0}, allocations{0}, allocated_bytes{0};
+    };
+
+    // zero-initialized before any dynamic initialization, so allocations of static constructors may count too
+    AtomicCounters counters[instrumentation::operation_count];
+
+    // the operation counted on this thread, or operation_count if none
+    thread_local std::size_t current = instrumentation::operation_count;
+
+    std::uint64_t now() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+#endif // LMPA_INSTRUMENTATION
+}
+
+
+/// Utility ///
+
+const char* instrumentation::name(Operation operation) {
+    return names[static_cast<std::size_t>(operation)];
+}
+
+instrumentation::Snapshot instrumentation::snapshot() {
+    Snapshot result;
+#ifdef LMPA_INSTRUMENTATION
+    for (std::size_t i = 0; i < operation_count; ++i) {
+        result[i].calls = counters[i].calls.load(std::memory_order_relaxed);
+        result[i].operand_bits = counters[i].operand_bits.load(std::memory_order_relaxed);
+        result[i].nanoseconds = counters[i].nanoseconds.load(std::memory_order_relaxed);
+        result[i].allocations = counters[i].allocations.load(std::memory_order_relaxed);
+        result[i].allocated_bytes = counters[i].allocated_bytes.load(std::memory_order_relaxed);
+    }
+#endif // LMPA_INSTRUMENTATION
+    return result;
+}
+
+void instrumentation::reset() {
+#ifdef LMPA_INSTRUMENTATION
+    for (AtomicCounters& c : counters) {
+        c.calls = 0;
+        c.operand_bits = 0;
+        c.nanoseconds = 0;
+        c.allocations = 0;
+        c.allocated_bytes = 0;
+    }
+#endif // LMPA_INSTRUMENTATION
+}
+
+
+#ifdef LMPA_INSTRUMENTATION
+
+/// Scope ///
+
+instrumentation::Scope::Scope(Operation operation, std::uint64_t operand_bits)
+        : outermost(current == operation_count), start(0) {
+    if (!outermost) { return; }
+    current = static_cast<std::size_t>(operation);
+    counters[current].calls.fetch_add(1, std::memory_order_relaxed);
+    counters[current].operand_bits.fetch_add(operand_bits, std::memory_order_relaxed);
+    start = now();
+}
+
+instrumentation::Scope::~Scope() {
+    if (!outermost) { return; }
+    counters[current].nanoseconds.fetch_add(now() - start, std::memory_order_relaxed);
+    current = operation_count;
+}
+
+
+/// Allocation Counting ///
+
+void instrumentation::count_allocation(std::size_t bytes) {
+    if (current != operation_count) {
+        counters[current].allocations.fetch_add(1, std::memory_order_relaxed);
+        counters[current].allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+#endif // LMPA_INSTRUMENTATION
@@ -0,0 +1,110 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_INSTRUMENTATION_H
+#define LMPA_LIBRARY_INSTRUMENTATION_H
+
+#include <array> // snapshot
+#include <cstdint> // uint64_t
+#include <cstddef> // size_t
+#include <memory> // allocator
+
+/**
+ * \brief Optional counters of the Binary operations: calls, operand bits, wall time and heap allocations.
+ * Only compiled in with LMPA_INSTRUMENTATION defined (the CMake option of the same name), otherwise
+ * the measurement points expand to nothing and snapshots stay empty.
+ * Allocations are counted by the Allocator of the digit and limb storage and attributed to the outermost
+ * operation running on the allocating thread, so the copies made inside an operation count towards it.
+ */
+namespace instrumentation {
+
+#ifdef LMPA_INSTRUMENTATION
+    constexpr bool enabled = true;
+#else
+    constexpr bool enabled = false;
+#endif // LMPA_INSTRUMENTATION
+
+    enum class Operation {
+        Assign, Add, Subtract, Multiply, Divide, Modulo, ShiftLeft, ShiftRight,
+        Increment, Decrement, Negate, AbsVal, Compare, Print
+    };
+    constexpr std::size_t operation_count = static_cast<std::size_t>(Operation::Print) + 1;
+
+    struct Counters {
+        std::uint64_t calls = 0;
+        // sum of the precisions of the operands
+        std::uint64_t operand_bits = 0;
+        std::uint64_t nanoseconds = 0;
+        std::uint64_t allocations = 0;
+        std::uint64_t allocated_bytes = 0;
+    };
+
+    typedef std::array<Counters, operation_count>   Snapshot;
+
+    /// Utility ///
+    const char* name(Operation operation);
+    // the counters of all threads since the last reset, indexed by Operation
+    Snapshot snapshot();
+    void reset();
+
+#ifdef LMPA_INSTRUMENTATION
+    /**
+     * \brief Counts an operation from construction to destruction, unless another operation
+     * is already counted on this thread.
+     */
+    class Scope {
+    public:
+        Scope(Operation operation, std::uint64_t operand_bits);
+        ~Scope();
+
+        Scope(const Scope& s) = delete;
+        Scope& operator=(const Scope& s) = delete;
+
+    private:
+        bool outermost;
+        std::uint64_t start;
+    };
+
+    // counts an allocation towards the operation counted on this thread, if any
+    void count_allocation(std::size_t bytes);
+#endif // LMPA_INSTRUMENTATION
+
+    /**
+     * \brief The allocator of the digit and limb storage, it counts its allocations with LMPA_INSTRUMENTATION
+     * defined and is the standard allocator otherwise.
+     */
+    template<typename T>
+    class Allocator {
+    public:
+        typedef T value_type;
+
+        Allocator() = default;
+        template<typename U>
+        Allocator(const Allocator<U>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+#ifdef LMPA_INSTRUMENTATION
+            count_allocation(n * sizeof(T));
+#endif // LMPA_INSTRUMENTATION
+            return std::allocator<T>().allocate(n);
+        }
+        void deallocate(T* p, std::size_t n) noexcept { std::allocator<T>().deallocate(p, n); }
+    };
+
+    template<typename T, typename U>
+    inline bool operator==(const Allocator<T>&, const Allocator<U>&) { return true; }
+    template<typename T, typename U>
+    inline bool operator!=(const Allocator<T>&, const Allocator<U>&) { return false; }
+
+}
+
+#ifdef LMPA_INSTRUMENTATION
+#define LMPA_INSTRUMENT(operation, bits) \
+    const instrumentation::Scope lmpa_instrumentation_scope(instrumentation::Operation::operation, (bits))
+#else
+#define LMPA_INSTRUMENT(operation, bits) static_cast<void>(0)
+#endif // LMPA_INSTRUMENTATION
+
+
+#endif //LMPA_LIBRARY_INSTRUMENTATION_H
@@ -0,0 +1,388 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Kernels.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LMPA_KERNELS_X86 1
+#include <cpuid.h> // feature detection
+#include <immintrin.h> // intrinsics
+#endif // x86-64 check
+
+using kernels::limb_type;
+using kernels::size_type;
+using kernels::Path;
+using kernels::mul_ll;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+
+    /// Generic ///
+
+    limb_type add_nc_generic(limb_type* r, const limb_type* a, const limb_type* b, size_type n, limb_type carry) {
+        for (size_type i = 0; i < n; ++i) {
+            limb_type s = a[i] + carry;
+            carry = s < carry;
+            limb_type t = s + b[i];
+            carry += t < s;
+            r[i] = t;
+        }
+        return carry;
+    }
+
+    limb_type sub_nc_generic(limb_type* r, const limb_type* a, const limb_type* b, size_type n, limb_type borrow) {
+        for (size_type i = 0; i < n; ++i) {
+            limb_type s = b[i] + borrow;
+            borrow = s < borrow;
+            limb_type d = a[i] - s;
+            borrow += d > a[i];
+            r[i] = d;
+        }
+        return borrow;
+    }
+
+    limb_type add_n_generic(limb_type* r, const limb_type* a, const limb_type* b, size_type n) {
+        return add_nc_generic(r, a, b, n, 0);
+    }
+
+    limb_type sub_n_generic(limb_type* r, const limb_type* a, const limb_type* b, size_type n) {
+        return sub_nc_generic(r, a, b, n, 0);
+    }
+
+    limb_type mul_1_generic(limb_type* r, const limb_type* a, size_type n, limb_type b) {
+        limb_type carry = 0;
+        for (size_type i = 0; i < n; ++i) {
+            limb_type hi;
+            limb_type lo = mul_ll(a[i], b, hi);
+            lo += carry;
+            carry = hi + (lo < carry);
+            r[i] = lo;
+        }
+        return carry;
+    }
+
+    limb_type addmul_1_generic(limb_type* r, const limb_type* a, size_type n, limb_type b) {
+        limb_type carry = 0;
+        for (size_type i = 0; i < n; ++i) {
+            limb_type hi;
+            limb_type lo = mul_ll(a[i], b, hi);
+            lo += carry;
+            hi += lo < carry;
+            lo += r[i];
+            hi += lo < r[i];
+            r[i] = lo;
+            carry = hi;
+        }
+        return carry;
+    }
+
+    void mul_basecase_generic(limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn) {
+        r[an] = mul_1_generic(r, a, an, b[0]);
+        for (size_type j = 1; j < bn; ++j) {
+            r[an + j] = addmul_1_generic(r + j, a, an, b[j]);
+        }
+    }
+
+#ifdef LMPA_KERNELS_X86
+
+    /// AVX2 ///
+
+    /**
+     * \brief Spreads the lowest four bits of mask over four 64 bit lanes, one bit (0 or 1) per lane.
+     */
+    __attribute__((target("avx2")))
+    inline __m256i expand_mask(unsigned mask) {
+        const __m256i lanes = _mm256_set_epi64x(3, 2, 1, 0);
+        __m256i bits = _mm256_srlv_epi64(_mm256_set1_epi64x(static_cast<long long>(mask)), lanes);
+        return _mm256_and_si256(bits, _mm256_set1_epi64x(1));
+    }
+
+    /**
+     * \brief Resolves the carries of four lanes at once. Lanes that generated a carry (g) pass it on,
+     * lanes that are saturated (p) propagate an incoming carry. Adding both masks ripples the carries
+     * through the lanes in a single scalar addition.
+     * Returns the mask of lanes that receive a carry and sets carry to the carry out of the highest lane.
+     */
+    inline unsigned resolve_carries(unsigned g, unsigned p, unsigned& carry) {
+        unsigned x = ((g << 1) | carry) + p;
+        carry = (x >> 4) & 1;
+        return (x ^ p) & 0xF;
+    }
+
+    /**
+     * \brief Adds four limbs at a time and resolves the carries between the lanes with resolve_carries.
+     */
+    __attribute__((target("avx2")))
+    limb_type add_n_avx2(limb_type* r, const limb_type* a, const limb_type* b, size_type n) {
+        const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        unsigned carry = 0;
+        size_type i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i s = _mm256_add_epi64(va, vb);
+            // the lane generated a carry if s < a (unsigned)
+            __m256i gen = _mm256_cmpgt_epi64(_mm256_xor_si256(va, bias), _mm256_xor_si256(s, bias));
+            __m256i prop = _mm256_cmpeq_epi64(s, ones);
+            unsigned g = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(gen)));
+            unsigned p = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(prop)));
+            unsigned in = resolve_carries(g, p, carry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_add_epi64(s, expand_mask(in)));
+        }
+        return add_nc_generic(r + i, a + i, b + i, n - i, carry);
+    }
+
+    /**
+     * \brief Subtracts four limbs at a time. Borrows are resolved like the carries in add_n_avx2,
+     * with zero lanes propagating an incoming borrow.
+     */
+    __attribute__((target("avx2")))
+    limb_type sub_n_avx2(limb_type* r, const limb_type* a, const limb_type* b, size_type n) {
+        const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+        const __m256i zero = _mm256_setzero_si256();
+        unsigned borrow = 0;
+        size_type i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i d = _mm256_sub_epi64(va, vb);
+            // the lane generated a borrow if a < b (unsigned)
+            __m256i gen = _mm256_cmpgt_epi64(_mm256_xor_si256(vb, bias), _mm256_xor_si256(va, bias));
+            __m256i prop = _mm256_cmpeq_epi64(d, zero);
+            unsigned g = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(gen)));
+            unsigned p = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(prop)));
+            unsigned in = resolve_carries(g, p, borrow);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_sub_epi64(d, expand_mask(in)));
+        }
+        return sub_nc_generic(r + i, a + i, b + i, n - i, borrow);
+    }
+
+    /// ADX, BMI2 ///
+
+    __attribute__((target("adx,bmi2")))
+    limb_type add_n_adx(limb_type* r, const limb_type* a, const limb_type* b, size_type n) {
+        unsigned char carry = 0;
+        for (size_type i = 0; i < n; ++i) {
+            unsigned long long s;
+            carry = _addcarryx_u64(carry, a[i], b[i], &s);
+            r[i] = s;
+        }
+        return carry;
+    }
+
+    __attribute__((target("adx,bmi2")))
+    limb_type sub_n_adx(limb_type* r, const limb_type* a, const limb_type* b, size_type n) {
+        unsigned char borrow = 0;
+        for (size_type i = 0; i < n; ++i) {
+            unsigned long long d;
+            borrow = _subborrow_u64(borrow, a[i], b[i], &d);
+            r[i] = d;
+        }
+        return borrow;
+    }
+
+    __attribute__((target("adx,bmi2")))
+    limb_type mul_1_adx(limb_type* r, const limb_type* a, size_type n, limb_type b) {
+        unsigned long long carry = 0;
+        unsigned char c = 0;
+        for (size_type i = 0; i < n; ++i) {
+            unsigned long long hi;
+            unsigned long long lo = _mulx_u64(a[i], b, &hi);
+            c = _addcarryx_u64(c, lo, carry, &lo);
+            r[i] = lo;
+            carry = hi;
+        }
+        // cannot overflow, the high limb of a product is at most 2^64 - 2
+        return carry + c;
+    }
+
+    /**
+     * \brief r += a * b using mulx and two independent carry chains: adcx accumulates the low
+     * product halves into r (CF), adox accumulates the high halves of the previous limb (OF).
+     * The loop is controlled by lea and jrcxz, which leave both flags untouched.
+     */
+    __attribute__((target("adx,bmi2")))
+    limb_type addmul_1_adx(limb_type* r, const limb_type* a, size_type n, limb_type b) {
+        if (n == 0) { return 0; }
+        limb_type carry;
+        __asm__ volatile(
+                "xorl %%eax, %%eax\n\t" // clears CF and OF, rax holds the previous high limb
+                "1:\n\t"
+                "mulx (%[a]), %%r8, %%r9\n\t"
+                "adcx (%[r]), %%r8\n\t"
+                "adox %%rax, %%r8\n\t"
+                "movq %%r8, (%[r])\n\t"
+                "movq %%r9, %%rax\n\t"
+                "leaq 8(%[a]), %[a]\n\t"
+                "leaq 8(%[r]), %[r]\n\t"
+                "leaq -1(%%rcx), %%rcx\n\t"
+                "jrcxz 2f\n\t"
+                "jmp 1b\n\t"
+                "2:\n\t"
+                "movl $0, %%r8d\n\t"
+                "adcx %%r8, %%rax\n\t"
+                "adox %%r8, %%rax\n\t"
+                : [r] "+r"(r), [a] "+r"(a), "+c"(n), "=a"(carry)
+                : "d"(b)
+                : "r8", "r9", "cc", "memory");
+        return carry;
+    }
+
+    __attribute__((target("adx,bmi2")))
+    void mul_basecase_adx(limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn) {
+        r[an] = mul_1_adx(r, a, an, b[0]);
+        for (size_type j = 1; j < bn; ++j) {
+            r[an + j] = addmul_1_adx(r + j, a, an, b[j]);
+        }
+    }
+
+#endif // LMPA_KERNELS_X86
+
+    /// Dispatch ///
+
+    struct Table {
+        Path path;
+        limb_type (*add_n)(limb_type*, const limb_type*, const limb_type*, size_type);
+        limb_type (*sub_n)(limb_type*, const limb_type*, const limb_type*, size_type);
+        limb_type (*mul_1)(limb_type*, const limb_type*, size_type, limb_type);
+        limb_type (*addmul_1)(limb_type*, const limb_type*, size_type, limb_type);
+        void (*mul_basecase)(limb_type*, const limb_type*, size_type, const limb_type*, size_type);
+    };
+
+    Table make_table(Path path) {
+        switch (path) {
+#ifdef LMPA_KERNELS_X86
+            case Path::ADX_BMI2:
+                return {path, add_n_adx, sub_n_adx, mul_1_adx, addmul_1_adx, mul_basecase_adx};
+            case Path::AVX2:
+                // AVX2 has no 64 bit multiplication, the multiplicative kernels stay scalar
+                return {path, add_n_avx2, sub_n_avx2, mul_1_generic, addmul_1_generic, mul_basecase_generic};
+#endif // LMPA_KERNELS_X86
+            default:
+                return {Path::Generic, add_n_generic, sub_n_generic, mul_1_generic, addmul_1_generic,
+                        mul_basecase_generic};
+        }
+    }
+
+    Path detect() {
+#ifdef LMPA_KERNELS_X86
+        if (kernels::supported(Path::ADX_BMI2)) { return Path::ADX_BMI2; }
+        if (kernels::supported(Path::AVX2)) { return Path::AVX2; }
+#endif // LMPA_KERNELS_X86
+        return Path::Generic;
+    }
+
+    /**
+     * \brief The dispatch table, initialized on first use (thread-safe since C++11).
+     */
+    Table& table() {
+        static Table t = make_table(detect());
+        return t;
+    }
+
+}
+
+
+/// Kernels ///
+
+limb_type kernels::add_n(limb_type* r, const limb_type* a, const limb_type* b, size_type n) {
+    return table().add_n(r, a, b, n);
+}
+
+limb_type kernels::sub_n(limb_type* r, const limb_type* a, const limb_type* b, size_type n) {
+    return table().sub_n(r, a, b, n);
+}
+
+limb_type kernels::mul_1(limb_type* r, const limb_type* a, size_type n, limb_type b) {
+    return table().mul_1(r, a, n, b);
+}
+
+limb_type kernels::addmul_1(limb_type* r, const limb_type* a, size_type n, limb_type b) {
+    return table().addmul_1(r, a, n, b);
+}
+
+void kernels::mul_basecase(limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn) {
+    table().mul_basecase(r, a, an, b, bn);
+}
+
+/**
+ * \brief r = a * a. Every product a[i] * a[j] with i != j appears twice in the square, so the triangle
+ * with i < j is computed once with the multiplicative kernels and doubled by a shift,
+ * then the squares a[i] * a[i] on the diagonal are added. This takes about half the products of mul_basecase.
+ */
+void kernels::sqr_basecase(limb_type* r, const limb_type* a, size_type n) {
+    r[0] = 0;
+    r[2 * n - 1] = 0;
+    if (n > 1) {
+        // row i is a[i] * a[i + 1 .. n), starting at limb 2 * i + 1
+        r[n] = kernels::mul_1(r + 1, a + 1, n - 1, a[0]);
+        for (size_type i = 1; i + 1 < n; ++i) {
+            r[n + i] = kernels::addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        }
+        r[2 * n - 1] = kernels::lshift(r + 1, r + 1, 2 * n - 2, 1);
+    }
+
+    limb_type carry = 0;
+    for (size_type i = 0; i < n; ++i) {
+        limb_type hi;
+        const limb_type lo = mul_ll(a[i], a[i], hi);
+        limb_type s = r[2 * i] + lo;
+        limb_type c = s < lo;
+        s += carry;
+        c += s < carry;
+        r[2 * i] = s;
+        limb_type t = r[2 * i + 1] + hi;
+        carry = t < hi;
+        t += c;
+        carry += t < c;
+        r[2 * i + 1] = t;
+    }
+}
+
+
+/// Dispatch ///
+
+/**
+ * \brief Returns whether the host cpu (and operating system) supports the given kernel path.
+ */
+bool kernels::supported(Path path) {
+    switch (path) {
+        case Path::Generic:
+            return true;
+#ifdef LMPA_KERNELS_X86
+        case Path::AVX2:
+            // also checks that the operating system saves the ymm registers
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case Path::ADX_BMI2: {
+            unsigned int eax, ebx, ecx, edx;
+            if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) { return false; }
+            constexpr unsigned int bmi2 = 1u << 8;
+            constexpr unsigned int adx = 1u << 19;
+            return (ebx & bmi2) && (ebx & adx);
+        }
+#endif // LMPA_KERNELS_X86
+        default:
+            return false;
+    }
+}
+
+/**
+ * \brief Returns the kernel path currently in use.
+ */
+Path kernels::active_path() {
+    return table().path;
+}
+
+/**
+ * \brief Switches all kernels to the given path. Not thread safe.
+ */
+bool kernels::select_path(Path path) {
+    if (!supported(path)) { return false; }
+    table() = make_table(path);
+    return true;
+}
@@ -0,0 +1,111 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_KERNELS_H
+#define LMPA_LIBRARY_KERNELS_H
+
+#include <cstdint> // uint64_t
+#include <cstddef> // size_t
+#include <vector> // container
+
+#include "Instrumentation.h"
+
+// compiles a function for several instruction sets, the loader picks the best one for the host cpu
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__) && defined(__linux__)
+#define LMPA_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define LMPA_TARGET_CLONES
+#endif // target clones check
+
+class ThreadPool;
+
+/**
+ * \brief Low-level limb kernels operating on little-endian arrays of 64 bit limbs.
+ * The implementation used is selected once at startup depending on the features the host cpu supports.
+ */
+namespace kernels {
+
+    typedef std::uint64_t                           limb_type;
+    typedef std::size_t                             size_type;
+    // limb storage of the arbitrary size layers, its allocations are instrumented
+    typedef std::vector<limb_type, instrumentation::Allocator<limb_type>> container_type;
+
+    constexpr size_type limb_bits = 64;
+
+    // number of limbs needed to hold the given amount of bits
+    constexpr size_type limbs_for(size_type bits) {
+        return bits / limb_bits + (bits % limb_bits != 0);
+    }
+
+    enum class Path {
+        Generic, // portable C++
+        AVX2, // vectorized carry propagation
+        ADX_BMI2 // mulx, adcx, adox
+    };
+
+    /// Limb Arithmetic ///
+    // a * b, returns the low limb and sets the high limb
+#ifdef __SIZEOF_INT128__
+    inline limb_type mul_ll(limb_type a, limb_type b, limb_type& hi) {
+        __extension__ typedef unsigned __int128 dlimb_type;
+        const dlimb_type p = static_cast<dlimb_type>(a) * b;
+        hi = static_cast<limb_type>(p >> 64);
+        return static_cast<limb_type>(p);
+    }
+#else
+    inline limb_type mul_ll(limb_type a, limb_type b, limb_type& hi) {
+        // schoolbook on 32 bit halves
+        const limb_type mask = 0xFFFFFFFFull;
+        limb_type a0 = a & mask, a1 = a >> 32, b0 = b & mask, b1 = b >> 32;
+        limb_type p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+        limb_type mid = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+        hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+        return (mid << 32) | (p00 & mask);
+    }
+#endif // __SIZEOF_INT128__
+
+    /// Kernels ///
+    // r = a + b, returns the carry out
+    limb_type add_n(limb_type* r, const limb_type* a, const limb_type* b, size_type n);
+    // r = a - b, returns the borrow out
+    limb_type sub_n(limb_type* r, const limb_type* a, const limb_type* b, size_type n);
+    // r = a * b, returns the high limb
+    limb_type mul_1(limb_type* r, const limb_type* a, size_type n, limb_type b);
+    // r += a * b, returns the high limb
+    limb_type addmul_1(limb_type* r, const limb_type* a, size_type n, limb_type b);
+    // r = a * b, r must hold an + bn limbs and must not overlap a or b, an and bn must not be 0
+    void mul_basecase(limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn);
+    // r = a * a, r must hold 2 * n limbs and must not overlap a, n must not be 0
+    void sqr_basecase(limb_type* r, const limb_type* a, size_type n);
+
+    /// Multiplication ///
+    // r = a * b, picks basecase or Karatsuba multiplication by size, or squaring if a and b are the same.
+    // Same requirements as mul_basecase. If a pool is given, the subproducts of large operands are computed on it
+    void mul(limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn,
+             ThreadPool* pool = nullptr);
+    // r = a * a, picks basecase or Karatsuba squaring by size. Same requirements as sqr_basecase
+    void sqr(limb_type* r, const limb_type* a, size_type n, ThreadPool* pool = nullptr);
+
+    /// Shifts ///
+    // r = a << s for 0 < s < limb_bits, returns the bits shifted out. r may equal a
+    limb_type lshift(limb_type* r, const limb_type* a, size_type n, unsigned s);
+    // r = a >> s for 0 < s < limb_bits, returns the bits shifted out in the high bits. r may equal a
+    limb_type rshift(limb_type* r, const limb_type* a, size_type n, unsigned s);
+
+    /// Division ///
+    // q = a / d, returns the remainder. q must hold n limbs, d must not be 0
+    limb_type divrem_1(limb_type* q, const limb_type* a, size_type n, limb_type d);
+    // q = a / b, r = a % b. q must hold an - bn + 1 limbs and r bn limbs. an >= bn and b[bn - 1] must not be 0
+    void divrem(limb_type* q, limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn);
+
+    /// Dispatch ///
+    bool supported(Path path);
+    Path active_path();
+    // not thread safe, intended for tests and benchmarks. Returns false if the path is not supported
+    bool select_path(Path path);
+
+}
+
+
+#endif //LMPA_LIBRARY_KERNELS_H
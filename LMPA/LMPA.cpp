@@ -4,213 +4,421 @@
 
 #include "LMPA.h"
 
+#include <cmath> // frexp, ldexp
+#include <limits> // int limits
+#include <stdexcept> // domain_error
+#include <string> // to_string
 
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    // guard bits kept beyond the precision by division and square root, so that the round bit is exact
+    constexpr LMPA::size_type guard_bits = 2;
+}
 
 
+/// Constructors ///
 
+/**
+ * \brief Default Constructor. Generates a 64 bit precision number of value 0.
+ */
+LMPA::LMPA() noexcept {
+}
 
+/**
+ * \brief Constructor with user-specified precision. The object's value will be 0.
+ */
+LMPA::LMPA(size_type precision) noexcept : _precision(std::max<size_type>(precision, 1)) {
+}
 
+/**
+ * \brief Constructor from an integer, rounded to the given precision.
+ */
+LMPA::LMPA(const Binary& b, size_type precision, RoundingModes mode) :
+        rounding(mode), _precision(std::max<size_type>(precision, 1)) {
+    round(b.magnitude(), b.sign(), 0, false);
+}
 
-/// LMPA Implementation ///
+/**
+ * \brief A double rounded to the given precision. Throws for infinities and NaN.
+ */
+LMPA LMPA::from_double(double d, size_type precision, RoundingModes mode) noexcept(false) {
+    if (!std::isfinite(d)) {
+        throw std::domain_error("LMPA initialized with a non-finite double: " + std::to_string(d));
+    }
+    LMPA result(precision);
+    result.rounding = mode;
+    int exp = 0;
+    const double fraction = std::frexp(std::fabs(d), &exp);
+    // doubles have 53 significant bits
+    const auto bits = static_cast<natural::limb_type>(std::ldexp(fraction, 53));
+    result.round(natural::from_limb(bits), d < 0, exp - 53, false);
+    return result;
+}
 
-//LMPA::LMPA() noexcept {
-//    pre_digits = "0";
-//}
-//
-//// TODO: update
-//LMPA::LMPA(std::string n, size_typeype prec) noexcept(false) {
-//    // check the string for validity
-//    if (!checkString(n)) {
-//        throw std::runtime_error("Invalid String given for Multiple Precision Number Initialization.");
-//    }
-//    // allows for multiple minuses and pluses, e.g. "--+-2" evaluates to sign = -1; pre_digits = "2"
-//    // as well as leading zeroes (note "-0-2" evaluates to sign = 1; pre_digits = "2")
-//    while (n[0] == '-' || n[0] == '+' || n[0] == '0') {
-//        if (n[0] == '-') {
-//            sign *= -1;
-//        }
-//        n.erase(0, 1); // erase the first character from n
-//    }
-//
-//    precision = prec;
-//
-//    size_typeype decimalpos = n.find('.');
-//    if (decimalpos == std::string::npos) {
-//        pre_digits = std::move(n);
-//        pre_length = pre_digits.length();
-//        return;
-//    }
-//    pre_digits = n.substr(0, decimalpos);
-//    std::string post_decimal_digit_result = n.substr(decimalpos + 1, std::min(n.length() - decimalpos - 1, precision));
-//    if (precision > n.length() - decimalpos - 1) {
-//        // add tailing zeroes
-//        post_decimal_digit_result.reserve(precision);
-//        while (post_decimal_digit_result.length() < precision) {
-//            post_decimal_digit_result += '0';
-//        }
-//    }
-//    post_digits = post_decimal_digit_result;
-//    pre_length = pre_digits.length();
-//}
-//
-//LMPA::LMPA(container_type n) noexcept {
-//    precision = 0;
-//    pre_digits = std::move(n);
-//}
-//
-//LMPA::LMPA(container_type pre, container_type post, size_typeype prec) noexcept {
-//    precision = prec;
-//    pre_digits = std::move(pre);
-//    post_digits = std::move(post);
-//}
-//
-//LMPA::LMPA(const LMPA&) {
-//    std::cout << "debug" << std::endl;
-//}
-//
-//int LMPA::toDigit(const char a) {
-//    return a - '0';
-//}
-//
-//char LMPA::toChar(const int a) {
-//    if (a > 9 || a < 0) {
-//        std::cerr << "Attempting conversion of invalid int to character: " << a << "!" << std::endl;
-//        return '0';
-//    }
-//    return static_cast<char>(a + '0');
-//}
-//
-//LMPA LMPA::operator+() const {
-//    return LMPA(this->getString(), this->precision);
-//}
-//
-//LMPA LMPA::operator-() const {
-//    return LMPA("-" + this->getString(), this->precision);
-//}
-//
-//int LMPA::insertDigit(std::string& result, int digit) {
-//    if (digit > 9) {
-//        result.insert(0, 1, toChar(digit - 10));
-//        return 1;
-//    } else if (digit < -9) {
-//        result.insert(0, 1, toChar(abs(digit + 10)));
-//        return -1;
-//    } else {
-//        result.insert(0, 1, toChar(abs(digit)));
-//        return 0;
-//    }
-//}
-//
-//// TODO: Test
-////  also add floating point support
-//LMPA LMPA::operator+(const LMPA& m) {
-//    size_typeype minSize = std::min(this->pre_digits.size(), m.pre_digits.size());
-//    size_typeype maxSize = std::max(this->pre_digits.size(), m.pre_digits.size());
-//    size_typeype i = 0;
-//
-//    container_type result;
-//    result.reserve(maxSize);
-//
-//    int add_subtract = 0;
-//
-//    // insert elements at the back of the vector and reverse at the end
-//    while (i < minSize) {
-//        int sum = this->pre_digits[i] + m.pre_digits[i] + add_subtract;
-//        add_subtract = this->pre_digits[i] && m.pre_digits[i];
-//        result.emplace_back(static_cast<value_type>(sum % 2));
-//        ++i;
-//    }
-//
-//    if (this->pre_digits.size() > m.pre_digits.size()) {
-//        while (i < maxSize) {
-//            int sum = this->pre_digits[i] + add_subtract;
-//            add_subtract = this->pre_digits[i] && add_subtract;
-//            result.emplace_back(static_cast<value_type>(sum % 2));
-//            ++i;
-//        }
-//    }
-//    if (m.pre_digits.size() > this->pre_digits.size()) {
-//        while (i < maxSize) {
-//            int sum = m.pre_digits[i] + add_subtract;
-//            add_subtract = m.pre_digits[i] && add_subtract;
-//            result.emplace_back(static_cast<value_type>(sum % 2));
-//            ++i;
-//        }
-//    }
-//    result.shrink_to_fit();
-//    std::reverse(result.begin(), result.end());
-//    return LMPA(result);
-//}
-//
-//LMPA LMPA::operator-(const LMPA& m) {
-//    return *this + (-m);
-//}
-//
-//std::ostream& operator<<(std::ostream& stream, const LMPA& m) {
-//    if (m.sign == -1) { stream << "-"; }
-//    stream << m.pre_digits;
-//    if (m.precision > 0) {
-//        stream << "." << m.post_digits;
-//    }
-//    return stream;
-//}
-//
-///** Checks a string for number initialization validity.
-// * Note that e.g. ".02" is an invalid string, whereas "0.02" is valid.
-// * @return whether the string is valid
-// */
-//value_type LMPA::checkString(const std::string& s) {
-//    value_type reachedNums = false;
-//    value_type reachedDecimal = false;
-//    for (const auto c : s) {
-//        // check if c is a sign
-//        if (c == '-' || c == '+') {
-//            if (reachedNums) { return false; }
-//            continue;
-//        }
-//        // check if c is a number
-//        if (c >= '0' && c <= '9') {
-//            reachedNums = true;
-//            continue;
-//        }
-//        if (c == '.') {
-//            if (!reachedNums) { return false; }
-//            if (reachedDecimal) { return false; }
-//            reachedDecimal = true;
-//            continue;
-//        }
-//        return false;
-//    }
-//    // only strings with actual numbers in them are valid
-//    return reachedNums;
-//}
-//
-//void LMPA::set_precision(size_typeype prec) {
-//    if (prec < precision) {
-//        post_digits = post_digits.substr(0, prec);
-//    } else {
-//        post_digits.reserve(prec);
-//        for (size_typeype i = precision; i < prec; ++i) {
-//            post_digits += '0';
-//        }
-//    }
-//    precision = prec;
-//}
-//
-//std::string LMPA::getString() const {
-//    std::string result;
-//    if (sign == -1) { result += '-'; }
-//    result += pre_digits;
-//    result += '.';
-//    result += post_digits;
-//    return result;
-//}
-//
-//container_type LMPA::toBinary(const std::string& s) {
-//    while ()
-//    return container_type();
-//}
 
+/// Utility ///
+
+/**
+ * \brief Sets the precision, rounding the value according to the rounding mode.
+ */
+void LMPA::set_precision(size_type prec) {
+    _precision = std::max<size_type>(prec, 1);
+    if (!is_zero()) {
+        round(mantissa_limbs, negative, _exponent, false);
+    }
+}
+
+/**
+ * \brief Returns the signed mantissa, the value being mantissa() * 2^exponent().
+ */
+Binary LMPA::mantissa() const {
+    return Binary::from_magnitude(mantissa_limbs, negative, precision() + 1);
+}
+
+LMPA LMPA::absVal() const {
+    LMPA result(*this);
+    result.negative = false;
+    return result;
+}
+
+/**
+ * \brief Returns the integer part, truncated toward zero.
+ */
+Binary LMPA::to_binary() const {
+    natural::container_type value;
+    if (_exponent >= 0) {
+        value = natural::shl(mantissa_limbs, static_cast<size_type>(_exponent));
+    } else {
+        value = natural::shr(mantissa_limbs, static_cast<size_type>(-_exponent));
+    }
+    return Binary::from_magnitude(value, negative && !value.empty());
+}
+
+/**
+ * \brief Returns the nearest double toward zero, also among the subnormals. Values out of the range of double
+ * become infinity or 0.
+ */
+double LMPA::to_double() const {
+    if (is_zero()) { return 0; }
+    LMPA truncated(*this);
+    truncated.rounding = RoundingModes::Toward_Zero;
+    truncated.set_precision(53);
+
+    // subnormal doubles have fewer significant bits, which are cut off here, since ldexp would round them
+    constexpr exponent_type min_exponent = std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits;
+    natural::limb_type bits = truncated.mantissa_limbs[0];
+    exponent_type exponent = truncated._exponent;
+    if (exponent < min_exponent) {
+        const exponent_type cut = min_exponent - exponent;
+        bits = cut < static_cast<exponent_type>(kernels::limb_bits) ? bits >> cut : 0;
+        exponent = min_exponent;
+    }
+
+    const auto exp = static_cast<int>(std::max<exponent_type>(std::min<exponent_type>(
+            exponent, std::numeric_limits<int>::max()), std::numeric_limits<int>::min()));
+    const double value = std::ldexp(static_cast<double>(bits), exp);
+    return negative ? -value : value;
+}
+
+/**
+ * \brief Sets the value to the exact (-1)^neg * exact * 2^exp, rounded to the precision.
+ * sticky marks that the exact value is slightly larger than given, i.e. that nonzero bits were cut off below it.
+ */
+void LMPA::round(natural::container_type exact, bool neg, exponent_type exp, bool sticky) {
+    natural::normalize(exact);
+    if (exact.empty()) {
+        mantissa_limbs.clear();
+        negative = false;
+        _exponent = 0;
+        return;
+    }
+
+    size_type bits = natural::bit_length(exact);
+    if (bits < precision() + guard_bits) {
+        // widen, so that the round bit lies within the value
+        const size_type widen = precision() + guard_bits - bits;
+        exact = natural::shl(exact, widen);
+        exp -= static_cast<exponent_type>(widen);
+        bits += widen;
+    }
+
+    const size_type shift = bits - precision();
+    const bool round_bit = natural::bit(exact, shift - 1);
+    sticky = sticky || natural::any_below(exact, shift - 1);
+    natural::container_type m = natural::shr(exact, shift);
+    exp += static_cast<exponent_type>(shift);
+
+    bool up = false;
+    switch (rounding) {
+        case RoundingModes::Nearest_Even:
+            up = round_bit && (sticky || natural::bit(m, 0));
+            break;
+        case RoundingModes::Toward_Zero:
+            break;
+        case RoundingModes::Toward_Positive:
+            up = !neg && (round_bit || sticky);
+            break;
+        case RoundingModes::Toward_Negative:
+            up = neg && (round_bit || sticky);
+            break;
+    }
+
+    if (up) {
+        m = natural::add(m, natural::from_limb(1));
+        if (natural::bit_length(m) > precision()) {
+            // rounded up to the next power of two
+            m = natural::shr(m, 1);
+            ++exp;
+        }
+    }
+
+    mantissa_limbs = std::move(m);
+    negative = neg;
+    _exponent = exp;
+}
+
+
+/// Assignment ///
+
+LMPA& LMPA::operator+=(const LMPA& m) {
+    return *this = *this + m;
+}
+
+LMPA& LMPA::operator-=(const LMPA& m) {
+    return *this = *this - m;
+}
+
+LMPA& LMPA::operator*=(const LMPA& m) {
+    return *this = *this * m;
+}
+
+LMPA& LMPA::operator/=(const LMPA& m) noexcept(false) {
+    return *this = *this / m;
+}
+
+
+/// Arithmetic ///
+
+/**
+ * \brief This does nothing.
+ */
+LMPA LMPA::operator+() const {
+    return *this;
+}
+
+/**
+ * \brief Inverts the sign of a copy.
+ */
+LMPA LMPA::operator-() const {
+    LMPA result(*this);
+    result.negative = !is_zero() && !negative;
+    return result;
+}
+
+/**
+ * \brief Adds (or subtracts) m exactly and rounds once. If m is far below the rounding position of the result,
+ * it is replaced by a single bit below the round bit, which rounds the same way but keeps the aligned sum short.
+ */
+LMPA LMPA::add(const LMPA& m, bool subtract) const {
+    LMPA result(std::max(precision(), m.precision()));
+    result.rounding = rounding;
+    const size_type prec = result.precision();
+
+    const LMPA* a = this;
+    const LMPA* b = &m;
+    bool sa = a->negative;
+    bool sb = b->negative ^ subtract;
+
+    if (b->is_zero()) {
+        result.round(a->mantissa_limbs, sa, a->_exponent, false);
+        return result;
+    }
+    if (a->is_zero()) {
+        result.round(b->mantissa_limbs, sb, b->_exponent, false);
+        return result;
+    }
+
+    // order by the position of the highest bit
+    auto top = [](const LMPA* x) {
+        return x->_exponent + static_cast<exponent_type>(natural::bit_length(x->mantissa_limbs));
+    };
+    if (top(a) < top(b)) {
+        std::swap(a, b);
+        std::swap(sa, sb);
+    }
+
+    natural::container_type mb = b->mantissa_limbs;
+    exponent_type eb = b->_exponent;
+    const exponent_type gap = static_cast<exponent_type>(prec) + 3;
+    if (top(b) + gap < top(a)) {
+        mb = natural::from_limb(1);
+        eb = top(a) - gap - 1;
+    }
+
+    const exponent_type e = std::min(a->_exponent, eb);
+    const natural::container_type ma = natural::shl(a->mantissa_limbs, static_cast<size_type>(a->_exponent - e));
+    mb = natural::shl(mb, static_cast<size_type>(eb - e));
+
+    if (sa == sb) {
+        result.round(natural::add(ma, mb), sa, e, false);
+    } else {
+        const int cmp = natural::compare(ma, mb);
+        if (cmp > 0) {
+            result.round(natural::sub(ma, mb), sa, e, false);
+        } else if (cmp < 0) {
+            result.round(natural::sub(mb, ma), sb, e, false);
+        }
+        // equal magnitudes leave the result at 0
+    }
+    return result;
+}
+
+/**
+ * \brief Addition Operator. Correctly rounded.
+ */
+LMPA LMPA::operator+(const LMPA& m) const {
+    return add(m, false);
+}
+
+/**
+ * \brief Subtraction Operator. Correctly rounded.
+ */
+LMPA LMPA::operator-(const LMPA& m) const {
+    return add(m, true);
+}
+
+/**
+ * \brief Multiplication Operator. Rounds the exact product of the mantissas.
+ * If either argument is dynamic, the result has enough precision to hold the exact product and is dynamic as well.
+ */
+LMPA LMPA::operator*(const LMPA& m) const {
+    const bool dynamic = storage_type == StorageType::Dynamic || m.storage_type == StorageType::Dynamic;
+    LMPA result(dynamic ? precision() + m.precision() : std::max(precision(), m.precision()));
+    result.rounding = rounding;
+    if (dynamic) { result.storage_type = StorageType::Dynamic; }
+    result.round(natural::mul(mantissa_limbs, m.mantissa_limbs), negative ^ m.negative,
+                 _exponent + m._exponent, false);
+    return result;
+}
+
+/**
+ * \brief Division Operator. The dividend is widened so that the quotient has guard bits,
+ * the remainder decides the sticky bit. May throw if the divisor has a value of 0.
+ */
+LMPA LMPA::operator/(const LMPA& m) const noexcept(false) {
+    if (m.is_zero()) {
+        throw div_by_zero_error();
+    }
+
+    LMPA result(std::max(precision(), m.precision()));
+    result.rounding = rounding;
+    if (is_zero()) { return result; }
+
+    const size_type la = natural::bit_length(mantissa_limbs);
+    const size_type lb = natural::bit_length(m.mantissa_limbs);
+    const size_type widen = std::max<size_type>(result.precision() + guard_bits + lb, la) - la;
+
+    natural::container_type q, r;
+    natural::divrem(natural::shl(mantissa_limbs, widen), m.mantissa_limbs, q, r);
+    result.round(q, negative ^ m.negative, _exponent - m._exponent - static_cast<exponent_type>(widen), !r.empty());
+    return result;
+}
+
+/**
+ * \brief Multiplication by 2^e, which only moves the exponent and is exact.
+ */
+LMPA LMPA::ldexp(exponent_type e) const {
+    LMPA result(*this);
+    if (!is_zero()) { result._exponent += e; }
+    return result;
+}
+
+/**
+ * \brief Square root, correctly rounded. Throws for negative values.
+ */
+LMPA LMPA::sqrt() const noexcept(false) {
+    if (negative) {
+        throw std::domain_error("Square root of a negative LMPA.");
+    }
+
+    LMPA result(precision());
+    result.rounding = rounding;
+    if (is_zero()) { return result; }
+
+    // the root of the widened mantissa needs precision + guard bits, and the exponent has to be even
+    const size_type bits = natural::bit_length(mantissa_limbs);
+    size_type widen = std::max<size_type>(2 * (precision() + guard_bits), bits) - bits;
+    if ((_exponent - static_cast<exponent_type>(widen)) % 2) { ++widen; }
+
+    const natural::container_type a = natural::shl(mantissa_limbs, widen);
+    natural::container_type s, r;
+    natural::sqrtrem(a, s, r);
+    result.round(s, false, (_exponent - static_cast<exponent_type>(widen)) / 2, !r.empty());
+    return result;
+}
+
+
+/// Comparison ///
+
+/**
+ * \brief Returns -1, 0 or 1 if the absolute value is less than, equal to or greater than that of m.
+ */
+int LMPA::compare_magnitude(const LMPA& m) const {
+    if (is_zero() || m.is_zero()) {
+        return static_cast<int>(!is_zero()) - static_cast<int>(!m.is_zero());
+    }
+
+    const exponent_type ta = _exponent + static_cast<exponent_type>(natural::bit_length(mantissa_limbs));
+    const exponent_type tb = m._exponent + static_cast<exponent_type>(natural::bit_length(m.mantissa_limbs));
+    if (ta != tb) { return ta < tb ? -1 : 1; }
+
+    // equal highest bits, so the shifts are bounded by the precisions
+    const exponent_type e = std::min(_exponent, m._exponent);
+    return natural::compare(natural::shl(mantissa_limbs, static_cast<size_type>(_exponent - e)),
+                            natural::shl(m.mantissa_limbs, static_cast<size_type>(m._exponent - e)));
+}
+
+bool LMPA::operator==(const LMPA& m) const {
+    return negative == m.negative && compare_magnitude(m) == 0;
+}
+
+bool LMPA::operator!=(const LMPA& m) const {
+    return !(*this == m);
+}
+
+bool LMPA::operator<(const LMPA& m) const {
+    if (negative != m.negative) { return negative; }
+    const int cmp = compare_magnitude(m);
+    return negative ? cmp > 0 : cmp < 0;
+}
+
+bool LMPA::operator>(const LMPA& m) const {
+    return m < *this;
+}
+
+bool LMPA::operator<=(const LMPA& m) const {
+    return !(m < *this);
+}
 
+bool LMPA::operator>=(const LMPA& m) const {
+    return !(*this < m);
+}
 
 
+/**
+ * \brief Stream Output Operator. Prints the binary mantissa and the exponent, e.g. -0b1011p-3 for -11 * 2^-3.
+ */
+std::ostream& operator<<(std::ostream& stream, const LMPA& m) {
+    if (m.negative) { stream << "-"; }
+    stream << "0b";
+    if (m.is_zero()) {
+        stream << "0";
+    }
+    for (LMPA::size_type i = natural::bit_length(m.mantissa_limbs); i-- > 0;) {
+        stream << natural::bit(m.mantissa_limbs, i);
+    }
+    stream << "p" << m._exponent;
+    return stream;
+}
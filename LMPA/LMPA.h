@@ -7,12 +7,21 @@
 
 #include <vector> // container
 #include <cstddef> // size_type
+#include <cstdint> // exponent_type
 #include <iostream> // operator<< stream overload
 
 #include "Binary.h"
+#include "Natural.h"
 
+/**
+ * \brief Arbitrary precision binary floating point number: (-1)^sign * mantissa * 2^exponent.
+ * The mantissa always has exactly precision() significant bits (unless the value is 0),
+ * and every operation is correctly rounded to the precision of the result according to the rounding mode.
+ */
 class LMPA {
 public:
+    typedef Binary::size_type                       size_type;
+    typedef std::int64_t                            exponent_type;
 
     enum class Type {
         Unsigned_Floating_Point,
@@ -21,92 +30,91 @@ public:
         Signed_Integer
     };
 
-    enum class StorageType {
-        Static, // static precision, the user has to take care of allocating more precision when necessary
-        Dynamic // dynamically increases and decreases precision, e.g. when multiplying to always be able to hold the result
+    // Static rounds every result to the operands' precision, Dynamic multiplication keeps the exact product
+    typedef Binary::StorageType                     StorageType;
+
+    enum class RoundingModes {
+        Nearest_Even,
+        Toward_Zero,
+        Toward_Positive,
+        Toward_Negative
     };
 
     StorageType storage_type = StorageType::Static;
-    Type type = Type::Signed_Integer;
-
-
+    Type type = Type::Signed_Floating_Point;
+    RoundingModes rounding = RoundingModes::Nearest_Even;
+
+
+    /// Constructors ///
+    LMPA() noexcept;
+    explicit LMPA(size_type precision) noexcept;
+    explicit LMPA(const Binary& b, size_type precision = 64, RoundingModes mode = RoundingModes::Nearest_Even);
+    // d rounded to the given precision. Throws std::domain_error for infinities and NaN
+    static LMPA from_double(double d, size_type precision = 53, RoundingModes mode = RoundingModes::Nearest_Even) noexcept(false);
+
+    LMPA(const LMPA& m) = default;
+    LMPA(LMPA&& m) = default;
+
+    ~LMPA() = default;
+
+
+    /// Utility ///
+    inline size_type precision() const { return _precision; }
+    void set_precision(size_type prec); // rounds the value to the new precision
+    inline bool sign() const { return negative; }
+    inline bool is_zero() const { return mantissa_limbs.empty(); }
+    inline exponent_type exponent() const { return _exponent; }
+    Binary mantissa() const;
+    LMPA absVal() const;
+    // both truncate toward zero
+    Binary to_binary() const;
+    double to_double() const;
+
+
+    /// Assignment ///
+    // all assignment operators may safely promote the assigned-to object's precision
+    LMPA& operator=(const LMPA& m) = default;
+    LMPA& operator=(LMPA&& m) = default;
+    LMPA& operator+=(const LMPA& m);
+    LMPA& operator-=(const LMPA& m);
+    LMPA& operator*=(const LMPA& m);
+    LMPA& operator/=(const LMPA& m) noexcept(false);
+
+    /// Arithmetic ///
+    // results are of the maximum precision of the two arguments and use the left argument's rounding mode
+    LMPA operator+() const;
+    LMPA operator-() const;
+
+    LMPA operator+(const LMPA& m) const;
+    LMPA operator-(const LMPA& m) const;
+    LMPA operator*(const LMPA& m) const;
+    LMPA operator/(const LMPA& m) const noexcept(false);
+    LMPA sqrt() const noexcept(false);
+    // exactly * 2^e
+    LMPA ldexp(exponent_type e) const;
+
+    /// Comparison ///
+    bool operator==(const LMPA& m) const;
+    bool operator!=(const LMPA& m) const;
+    bool operator<(const LMPA& m) const;
+    bool operator>(const LMPA& m) const;
+    bool operator<=(const LMPA& m) const;
+    bool operator>=(const LMPA& m) const;
+
+
+    friend std::ostream& operator<< (std::ostream& stream, const LMPA& m);
 
 private:
+    size_type _precision = 64; // mantissa bits
+    bool negative = false;
+    exponent_type _exponent = 0;
+    natural::container_type mantissa_limbs; // empty for 0
 
-    Binary pre_radix;
-    Binary post_radix;
-
+    void round(natural::container_type exact, bool neg, exponent_type exp, bool sticky);
+    LMPA add(const LMPA& m, bool subtract) const;
+    int compare_magnitude(const LMPA& m) const;
 
 };
 
-//class LMPA {
-//private:
-//
-//    std::vector<bool> pre_digits;
-//    std::vector<bool> post_digits;
-//    // 0 for integer-only
-//    std::size_t precision = 0;
-//
-//    int sign = 1;
-//
-//    int toDigit(char a);
-//    char toChar(int a);
-//    std::vector<bool> toBinary(const std::string& s);
-//    std::string toString(const std::vector<bool>& v);
-//
-//    int insertDigit(std::string& result, int digit);
-//
-//    static bool checkString(const std::string& s);
-//
-//public:
-//
-//    LMPA() noexcept;
-//    explicit LMPA(std::string n, std::size_t prec) noexcept(false);
-//    explicit LMPA(std::vector<bool> n) noexcept;
-//    explicit LMPA(std::vector<bool> pre, std::vector<bool> post, std::size_t prec) noexcept;
-//    LMPA(const LMPA& m);
-//
-//    /// Arithmetic ///
-//    LMPA operator+() const;
-//    LMPA operator-() const;
-//
-//    LMPA operator+(const LMPA& m);
-//    LMPA operator-(const LMPA& m);
-//    LMPA operator*(const LMPA& m);
-//    LMPA operator/(const LMPA& m);
-//    LMPA operator%(const LMPA& m);
-//
-//
-//    /// Assignment ///
-//    LMPA& operator=(const LMPA& m);
-//    LMPA& operator+=(const LMPA& m);
-//    LMPA& operator-=(const LMPA& m);
-//    LMPA& operator*=(const LMPA& m);
-//    LMPA& operator/=(const LMPA& m);
-//    LMPA& operator%=(const LMPA& m);
-//
-//    /// Logical ///
-//    bool operator==(const LMPA& m);
-//    bool operator!=(const LMPA& m);
-//    bool operator<(const LMPA& m);
-//    bool operator>(const LMPA& m);
-//    bool operator<=(const LMPA& m);
-//    bool operator>=(const LMPA& m);
-//
-//
-//    LMPA absVal();
-//
-//    std::size_t getPrecision() { return precision; }
-//
-//    void setPrecision(std::size_t prec);
-//
-//    std::string getString() const;
-//
-//    int getSign() { return sign; }
-//
-//    friend std::ostream& operator<< (std::ostream& stream, const LMPA& m);
-//
-//};
-
 
 #endif //MULTIPLEPRECISION_H
@@ -0,0 +1,126 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "ModBinary.h"
+
+typedef ModBinary::limb_type limb_type;
+typedef ModBinary::container_type container_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    // the scratch of a Montgomery product, reused by all products of a thread
+    limb_type* scratch(ModBinary::size_type n) {
+        static thread_local std::vector<limb_type> buffer;
+        if (buffer.size() < 2 * n) { buffer.resize(2 * n); }
+        return buffer.data();
+    }
+}
+
+
+/// Constructors ///
+
+ModBinary::context_type ModBinary::make_context(const Binary& m) noexcept(false) {
+    return std::make_shared<const Montgomery>(m.magnitude());
+}
+
+ModBinary::ModBinary(const Binary& a, context_type context) : ctx(std::move(context)), x(ctx->to_montgomery(a.magnitude())) {
+    if (a.sign()) {
+        const container_type zero(ctx->size(), 0);
+        ctx->sub(x.data(), zero.data(), x.data());
+    }
+}
+
+
+/// Utility ///
+
+Binary ModBinary::value() const {
+    return Binary::from_magnitude(ctx->from_montgomery(x), false, natural::bit_length(ctx->modulus()) + 1);
+}
+
+void ModBinary::check(const ModBinary& other) const noexcept(false) {
+    if (ctx != other.ctx && ctx->modulus() != other.ctx->modulus()) {
+        throw std::domain_error("Residues of different moduli.");
+    }
+}
+
+
+/// Assignment Operators ///
+
+ModBinary& ModBinary::operator+=(const ModBinary& other) noexcept(false) {
+    check(other);
+    ctx->add(x.data(), x.data(), other.x.data());
+    return *this;
+}
+
+ModBinary& ModBinary::operator-=(const ModBinary& other) noexcept(false) {
+    check(other);
+    ctx->sub(x.data(), x.data(), other.x.data());
+    return *this;
+}
+
+ModBinary& ModBinary::operator*=(const ModBinary& other) noexcept(false) {
+    check(other);
+    ctx->mul(x.data(), x.data(), other.x.data(), scratch(ctx->size()));
+    return *this;
+}
+
+
+/// Arithmetic Operators ///
+
+ModBinary ModBinary::operator+(const ModBinary& other) const noexcept(false) {
+    return ModBinary(*this) += other;
+}
+
+ModBinary ModBinary::operator-(const ModBinary& other) const noexcept(false) {
+    return ModBinary(*this) -= other;
+}
+
+ModBinary ModBinary::operator*(const ModBinary& other) const noexcept(false) {
+    return ModBinary(*this) *= other;
+}
+
+ModBinary ModBinary::operator-() const {
+    container_type result(ctx->size(), 0);
+    ctx->sub(result.data(), result.data(), x.data());
+    return ModBinary(ctx, std::move(result));
+}
+
+
+/// Arithmetic ///
+
+ModBinary ModBinary::sqr() const {
+    container_type result(ctx->size());
+    ctx->sqr(result.data(), x.data(), scratch(ctx->size()));
+    return ModBinary(ctx, std::move(result));
+}
+
+ModBinary ModBinary::inverse() const noexcept(false) {
+    container_type result;
+    if (!ctx->inverse(result, x)) {
+        throw std::domain_error("The residue is not invertible.");
+    }
+    return ModBinary(ctx, std::move(result));
+}
+
+/**
+ * \brief Montgomery's windowed exponentiation, negative exponents invert first.
+ */
+ModBinary ModBinary::pow(const Binary& e) const noexcept(false) {
+    const ModBinary base = e.sign() ? inverse() : *this;
+    return ModBinary(ctx, ctx->pow(base.x, e.magnitude()));
+}
+
+
+/// Comparison Operators ///
+
+bool ModBinary::operator==(const ModBinary& other) const noexcept(false) {
+    check(other);
+    return x == other.x;
+}
+
+bool ModBinary::operator!=(const ModBinary& other) const noexcept(false) {
+    return !(*this == other);
+}
@@ -0,0 +1,369 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_MODBINARY_H
+#define LMPA_LIBRARY_MODBINARY_H
+
+#include <array> // fixed limbs
+#include <memory> // shared_ptr
+#include <stdexcept> // domain_error
+
+#include "Binary.h"
+#include "Natural.h"
+#include "Montgomery.h"
+#include "GCD.h"
+
+/**
+ * \brief A residue modulo an odd number m, kept in Montgomery form across all operations, so that a product costs
+ * a multiplication and a Montgomery reduction instead of a division. The context of m is shared by all residues
+ * modulo m and computed once. Only value() converts back to the canonical residue.
+ * Operations on residues of different moduli throw std::domain_error.
+ */
+class ModBinary {
+public:
+    typedef Montgomery::limb_type                   limb_type;
+    typedef Montgomery::size_type                   size_type;
+    typedef Montgomery::container_type              container_type;
+    typedef std::shared_ptr<const Montgomery>       context_type;
+
+    /// Constructors ///
+    // the context of the modulus |m|. Throws std::domain_error if m is even or 0
+    static context_type make_context(const Binary& m) noexcept(false);
+    // a mod m, in [0, m) also for negative a
+    ModBinary(const Binary& a, context_type context);
+
+    ModBinary(const ModBinary& other) = default;
+    ModBinary(ModBinary&& other) = default;
+
+    ~ModBinary() = default;
+
+    /// Utility ///
+    inline const context_type& context() const { return ctx; }
+    // x * R mod m in n limbs
+    inline const container_type& montgomery() const { return x; }
+    // the canonical residue in [0, m), of the smallest precision holding all residues
+    Binary value() const;
+
+    /// Assignment Operators ///
+    ModBinary& operator=(const ModBinary& other) = default;
+    ModBinary& operator=(ModBinary&& other) = default;
+    ModBinary& operator+=(const ModBinary& other) noexcept(false);
+    ModBinary& operator-=(const ModBinary& other) noexcept(false);
+    ModBinary& operator*=(const ModBinary& other) noexcept(false);
+
+    /// Arithmetic Operators ///
+    ModBinary operator+(const ModBinary& other) const noexcept(false);
+    ModBinary operator-(const ModBinary& other) const noexcept(false);
+    ModBinary operator*(const ModBinary& other) const noexcept(false);
+    ModBinary operator-() const;
+
+    /// Arithmetic ///
+    ModBinary sqr() const;
+    // throws std::domain_error if gcd(x, m) is not 1
+    ModBinary inverse() const noexcept(false);
+    // x^e, negative exponents invert first
+    ModBinary pow(const Binary& e) const noexcept(false);
+
+    /// Comparison Operators ///
+    bool operator==(const ModBinary& other) const noexcept(false);
+    bool operator!=(const ModBinary& other) const noexcept(false);
+
+private:
+    context_type ctx;
+    container_type x; // x * R mod m in n limbs
+
+    ModBinary(context_type context, container_type montgomery) : ctx(std::move(context)), x(std::move(montgomery)) {}
+    void check(const ModBinary& other) const noexcept(false);
+
+};
+
+
+/**
+ * \brief ModBinary for moduli of at most Bits bits, with R = 2^Bits fixed at compile time. Residues are arrays of
+ * Bits / 64 limbs and the Montgomery product is an interleaved loop over them (CIOS, Koç, Acar and Kaliski,
+ * Analyzing and comparing Montgomery multiplication algorithms, 1996), which the compiler unrolls. Nothing is
+ * allocated per operation. The rare conversions and inverses go through natural numbers.
+ */
+template<Binary::size_type Bits>
+class FixedModBinary {
+    static_assert(Bits > 0 && Bits % kernels::limb_bits == 0, "FixedModBinary requires a whole number of limbs!");
+
+public:
+    typedef kernels::limb_type                      limb_type;
+    typedef kernels::size_type                      size_type;
+
+    static constexpr size_type limbs = Bits / kernels::limb_bits;
+    typedef std::array<limb_type, limbs>            limbs_type;
+
+    /**
+     * \brief The precomputed values of an odd modulus below 2^Bits.
+     */
+    class Context {
+    public:
+        // throws std::domain_error if m is even, 0 or not below 2^Bits
+        explicit Context(const Binary& modulus) noexcept(false) {
+            const natural::container_type magnitude = modulus.magnitude();
+            if (magnitude.empty() || !(magnitude[0] & 1) || magnitude.size() > limbs) {
+                throw std::domain_error("FixedModBinary requires an odd modulus below 2^Bits.");
+            }
+            m = to_array(magnitude);
+            precision = natural::bit_length(magnitude) + 1;
+
+            // Newton's iteration doubles the correct low bits of the inverse, m[0] itself is correct to 3 bits
+            limb_type inverse = m[0];
+            for (int i = 0; i < 5; ++i) {
+                inverse *= 2 - m[0] * inverse;
+            }
+            minv = ~inverse + 1;
+
+            r1 = to_array(reduce(natural::shl(natural::from_limb(1), Bits)));
+            r2 = to_array(reduce(natural::shl(natural::from_limb(1), 2 * Bits)));
+        }
+
+        inline const limbs_type& modulus() const { return m; }
+        inline const limbs_type& one() const { return r1; }
+
+        limbs_type to_montgomery(const natural::container_type& a) const { return mul(to_array(reduce(a)), r2); }
+
+        natural::container_type from_montgomery(const limbs_type& x) const {
+            limbs_type unit{};
+            unit[0] = 1;
+            const limbs_type canonical = mul(x, unit);
+            natural::container_type result(std::begin(canonical), std::end(canonical));
+            natural::normalize(result);
+            return result;
+        }
+
+        Binary value(const limbs_type& x) const { return Binary::from_magnitude(from_montgomery(x), false, precision); }
+
+        limbs_type add(const limbs_type& a, const limbs_type& b) const {
+            limbs_type r;
+            limb_type carry = 0;
+            for (size_type i = 0; i < limbs; ++i) {
+                const limb_type s = a[i] + carry;
+                carry = s < carry;
+                r[i] = s + b[i];
+                carry += r[i] < s;
+            }
+            if (carry || at_least(r, m)) { subtract(r, r, m); }
+            return r;
+        }
+
+        limbs_type sub(const limbs_type& a, const limbs_type& b) const {
+            limbs_type r;
+            if (subtract(r, a, b)) { add_modulus(r); }
+            return r;
+        }
+
+        /**
+         * \brief a * b / R mod m, reducing after each limb of b: t = (t + a * b[i] + u * m) / 2^64 with u chosen to
+         * clear the low limb. t stays below 2 m, so one subtraction at the end suffices.
+         */
+        limbs_type mul(const limbs_type& a, const limbs_type& b) const {
+            std::array<limb_type, limbs + 2> t{};
+            for (size_type i = 0; i < limbs; ++i) {
+                limb_type carry = 0;
+                for (size_type j = 0; j < limbs; ++j) {
+                    carry = muladd(t[j], a[j], b[i], carry);
+                }
+                t[limbs] += carry;
+                t[limbs + 1] = t[limbs] < carry;
+
+                const limb_type u = t[0] * minv;
+                carry = muladd(t[0], u, m[0], 0);
+                for (size_type j = 1; j < limbs; ++j) {
+                    t[j - 1] = t[j];
+                    carry = muladd(t[j - 1], u, m[j], carry);
+                }
+                t[limbs - 1] = t[limbs] + carry;
+                t[limbs] = t[limbs + 1] + (t[limbs - 1] < carry);
+            }
+
+            limbs_type r;
+            std::copy(std::begin(t), std::begin(t) + limbs, std::begin(r));
+            if (t[limbs] || at_least(r, m)) { subtract(r, r, m); }
+            return r;
+        }
+
+    private:
+        limbs_type m;
+        limbs_type r1; // R mod m
+        limbs_type r2; // R^2 mod m
+        limb_type minv; // -m^-1 mod 2^64
+        Binary::size_type precision; // of the canonical residues
+
+        static limbs_type to_array(const natural::container_type& a) {
+            limbs_type result{};
+            std::copy(std::begin(a), std::begin(a) + std::min<size_type>(a.size(), limbs), std::begin(result));
+            return result;
+        }
+
+        natural::container_type reduce(const natural::container_type& a) const {
+            natural::container_type modulus(std::begin(m), std::end(m)), q, r;
+            natural::normalize(modulus);
+            natural::divrem(a, modulus, q, r);
+            return r;
+        }
+
+        // x = lo(x + a * b + c), returns the high limb
+        static limb_type muladd(limb_type& x, limb_type a, limb_type b, limb_type c) {
+            limb_type hi;
+            limb_type lo = kernels::mul_ll(a, b, hi);
+            lo += c;
+            hi += lo < c;
+            lo += x;
+            hi += lo < x;
+            x = lo;
+            return hi;
+        }
+
+        static bool at_least(const limbs_type& a, const limbs_type& b) {
+            for (size_type i = limbs; i-- > 0;) {
+                if (a[i] != b[i]) { return a[i] > b[i]; }
+            }
+            return true;
+        }
+
+        // r = a - b modulo R, returns the borrow. r may equal a or b
+        static limb_type subtract(limbs_type& r, const limbs_type& a, const limbs_type& b) {
+            limb_type borrow = 0;
+            for (size_type i = 0; i < limbs; ++i) {
+                const limb_type d = a[i] - b[i];
+                const limb_type below = (a[i] < b[i]) | (d < borrow);
+                r[i] = d - borrow;
+                borrow = below;
+            }
+            return borrow;
+        }
+
+        // r += m modulo R
+        void add_modulus(limbs_type& r) const {
+            limb_type carry = 0;
+            for (size_type i = 0; i < limbs; ++i) {
+                const limb_type s = r[i] + carry;
+                carry = s < carry;
+                r[i] = s + m[i];
+                carry += r[i] < s;
+            }
+        }
+    };
+
+    typedef std::shared_ptr<const Context>          context_type;
+
+
+    /// Constructors ///
+    static context_type make_context(const Binary& m) noexcept(false) { return std::make_shared<const Context>(m); }
+
+    /**
+     * \brief a mod m, in [0, m) also for negative a.
+     */
+    FixedModBinary(const Binary& a, context_type context) : ctx(std::move(context)), x(ctx->to_montgomery(a.magnitude())) {
+        if (a.sign()) { x = ctx->sub(limbs_type{}, x); }
+    }
+
+    FixedModBinary(const FixedModBinary& other) = default;
+    FixedModBinary(FixedModBinary&& other) = default;
+
+    ~FixedModBinary() = default;
+
+
+    /// Utility ///
+    inline const context_type& context() const { return ctx; }
+    inline const limbs_type& montgomery() const { return x; }
+    // the canonical residue in [0, m), of the smallest precision holding all residues
+    Binary value() const { return ctx->value(x); }
+
+
+    /// Assignment Operators ///
+    FixedModBinary& operator=(const FixedModBinary& other) = default;
+    FixedModBinary& operator=(FixedModBinary&& other) = default;
+
+    FixedModBinary& operator+=(const FixedModBinary& other) noexcept(false) {
+        check(other);
+        x = ctx->add(x, other.x);
+        return *this;
+    }
+
+    FixedModBinary& operator-=(const FixedModBinary& other) noexcept(false) {
+        check(other);
+        x = ctx->sub(x, other.x);
+        return *this;
+    }
+
+    FixedModBinary& operator*=(const FixedModBinary& other) noexcept(false) {
+        check(other);
+        x = ctx->mul(x, other.x);
+        return *this;
+    }
+
+
+    /// Arithmetic Operators ///
+    FixedModBinary operator+(const FixedModBinary& other) const noexcept(false) { return FixedModBinary(*this) += other; }
+    FixedModBinary operator-(const FixedModBinary& other) const noexcept(false) { return FixedModBinary(*this) -= other; }
+    FixedModBinary operator*(const FixedModBinary& other) const noexcept(false) { return FixedModBinary(*this) *= other; }
+    FixedModBinary operator-() const { return FixedModBinary(ctx, ctx->sub(limbs_type{}, x)); }
+
+
+    /// Arithmetic ///
+    FixedModBinary sqr() const { return FixedModBinary(ctx, ctx->mul(x, x)); }
+
+    /**
+     * \brief The inverse by the extended GCD of the canonical value. Throws std::domain_error if gcd(x, m) is not 1.
+     */
+    FixedModBinary inverse() const noexcept(false) {
+        natural::container_type m(std::begin(ctx->modulus()), std::end(ctx->modulus()));
+        natural::normalize(m);
+        Binary result;
+        if (!invert(result, value(), Binary::from_magnitude(m, false))) {
+            throw std::domain_error("The residue is not invertible.");
+        }
+        return FixedModBinary(ctx, ctx->to_montgomery(result.magnitude()));
+    }
+
+    /**
+     * \brief x^e by square and multiply from the top bit of e, negative exponents invert first.
+     */
+    FixedModBinary pow(const Binary& e) const noexcept(false) {
+        const limbs_type base = e.sign() ? inverse().x : x;
+        const natural::container_type exponent = e.magnitude();
+        limbs_type result = ctx->one();
+        for (size_type i = natural::bit_length(exponent); i-- > 0;) {
+            result = ctx->mul(result, result);
+            if (natural::bit(exponent, i)) { result = ctx->mul(result, base); }
+        }
+        return FixedModBinary(ctx, result);
+    }
+
+
+    /// Comparison Operators ///
+    bool operator==(const FixedModBinary& other) const noexcept(false) {
+        check(other);
+        return x == other.x;
+    }
+
+    bool operator!=(const FixedModBinary& other) const noexcept(false) { return !(*this == other); }
+
+private:
+    context_type ctx;
+    limbs_type x; // x * R mod m
+
+    FixedModBinary(context_type context, const limbs_type& montgomery) : ctx(std::move(context)), x(montgomery) {}
+
+    void check(const FixedModBinary& other) const noexcept(false) {
+        if (ctx != other.ctx && ctx->modulus() != other.ctx->modulus()) {
+            throw std::domain_error("Residues of different moduli.");
+        }
+    }
+
+};
+
+template<Binary::size_type Bits>
+constexpr typename FixedModBinary<Bits>::size_type FixedModBinary<Bits>::limbs;
+
+typedef FixedModBinary<256>                         ModBinary256;
+typedef FixedModBinary<384>                         ModBinary384;
+typedef FixedModBinary<512>                         ModBinary512;
+
+
+#endif //LMPA_LIBRARY_MODBINARY_H
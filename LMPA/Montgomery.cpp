@@ -0,0 +1,173 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Montgomery.h"
+#include "GCD.h"
+
+#include <stdexcept> // domain_error
+
+using kernels::limb_type;
+using kernels::size_type;
+typedef Montgomery::container_type container_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    // window bits of the exponentiation
+    constexpr unsigned window = 4;
+
+    // x mod m, padded to n limbs
+    container_type reduce(const container_type& x, const container_type& m) {
+        container_type q, r;
+        natural::divrem(x, m, q, r);
+        r.resize(m.size(), 0);
+        return r;
+    }
+
+    // true if a >= b on n limbs each
+    bool at_least(const limb_type* a, const limb_type* b, size_type n) {
+        for (size_type i = n; i-- > 0;) {
+            if (a[i] != b[i]) { return a[i] > b[i]; }
+        }
+        return true;
+    }
+}
+
+
+/// Constructors ///
+
+/**
+ * \brief Precomputes -m^-1 mod 2^64, R mod m and R^2 mod m. Throws std::domain_error for an even modulus.
+ */
+Montgomery::Montgomery(const container_type& modulus) noexcept(false) : m(modulus) {
+    natural::normalize(m);
+    if (m.empty() || !(m[0] & 1)) {
+        throw std::domain_error("Montgomery arithmetic requires an odd modulus.");
+    }
+    n = m.size();
+
+    // Newton's iteration doubles the correct low bits of the inverse, m[0] itself is correct to 3 bits
+    limb_type inverse = m[0];
+    for (int i = 0; i < 5; ++i) {
+        inverse *= 2 - m[0] * inverse;
+    }
+    minv = ~inverse + 1;
+
+    r1 = reduce(natural::shl(natural::from_limb(1), n * kernels::limb_bits), m);
+    r2 = reduce(natural::shl(natural::from_limb(1), 2 * n * kernels::limb_bits), m);
+}
+
+
+/// Conversion ///
+
+container_type Montgomery::to_montgomery(const container_type& a) const {
+    return mul(reduce(a, m), r2);
+}
+
+container_type Montgomery::from_montgomery(const container_type& x) const {
+    container_type t(2 * n, 0);
+    std::copy(std::begin(x), std::end(x), std::begin(t));
+    container_type result(n);
+    redc(result.data(), t.data());
+    natural::normalize(result);
+    return result;
+}
+
+
+/// Arithmetic ///
+
+/**
+ * \brief Montgomery reduction r = t / R mod m for t < m * R of 2 * n limbs, t is overwritten.
+ * Adding u * m with u = t[i] * -m^-1 clears limb i, after n limbs the upper half is t / R mod m, up to one m.
+ */
+void Montgomery::redc(limb_type* r, limb_type* t) const {
+    limb_type top = 0;
+    for (size_type i = 0; i < n; ++i) {
+        limb_type carry = kernels::addmul_1(t + i, m.data(), n, t[i] * minv);
+        for (size_type j = i + n; carry && j < 2 * n; ++j) {
+            t[j] += carry;
+            carry = t[j] < carry;
+        }
+        top += carry;
+    }
+
+    if (top || at_least(t + n, m.data(), n)) {
+        kernels::sub_n(r, t + n, m.data(), n);
+    } else {
+        std::copy(t + n, t + 2 * n, r);
+    }
+}
+
+void Montgomery::add(limb_type* r, const limb_type* a, const limb_type* b) const {
+    if (kernels::add_n(r, a, b, n) || at_least(r, m.data(), n)) {
+        kernels::sub_n(r, r, m.data(), n);
+    }
+}
+
+void Montgomery::sub(limb_type* r, const limb_type* a, const limb_type* b) const {
+    if (kernels::sub_n(r, a, b, n)) {
+        kernels::add_n(r, r, m.data(), n);
+    }
+}
+
+void Montgomery::mul(limb_type* r, const limb_type* a, const limb_type* b, limb_type* scratch) const {
+    kernels::mul(scratch, a, n, b, n);
+    redc(r, scratch);
+}
+
+container_type Montgomery::mul(const container_type& a, const container_type& b) const {
+    container_type scratch(2 * n);
+    container_type result(n);
+    mul(result.data(), a.data(), b.data(), scratch.data());
+    return result;
+}
+
+/**
+ * \brief x^e with fixed windows of 4 bits from the top of e: four squarings and one multiplication
+ * by one of the precomputed powers x^0 .. x^15 per window.
+ */
+container_type Montgomery::pow(const container_type& x, const container_type& e) const {
+    std::vector<container_type> powers(size_type(1) << window);
+    powers[0] = r1;
+    powers[1] = x;
+    for (size_type i = 2; i < powers.size(); ++i) {
+        powers[i] = mul(powers[i - 1], x);
+    }
+
+    container_type scratch(2 * n);
+    container_type result = r1;
+    const size_type bits = natural::bit_length(e);
+    for (size_type i = (bits + window - 1) / window; i-- > 0;) {
+        size_type digit = 0;
+        for (unsigned b = window; b-- > 0;) {
+            digit = (digit << 1) | natural::bit(e, i * window + b);
+        }
+        if (i + 1 != (bits + window - 1) / window) {
+            for (unsigned s = 0; s < window; ++s) {
+                mul(result.data(), result.data(), result.data(), scratch.data());
+            }
+            if (digit) {
+                mul(result.data(), result.data(), powers[digit].data(), scratch.data());
+            }
+        } else {
+            // the top window
+            result = powers[digit];
+        }
+    }
+    return result;
+}
+
+/**
+ * \brief The inverse by the extended GCD of the canonical value, converted back. Inverses are rare enough
+ * next to products that the two conversions do not matter.
+ */
+bool Montgomery::inverse(container_type& r, const container_type& x) const {
+    Binary result;
+    if (!invert(result, Binary::from_magnitude(from_montgomery(x), false), Binary::from_magnitude(m, false))) {
+        return false;
+    }
+    r = to_montgomery(result.magnitude());
+    return true;
+}
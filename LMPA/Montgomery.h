@@ -0,0 +1,63 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_MONTGOMERY_H
+#define LMPA_LIBRARY_MONTGOMERY_H
+
+#include "Natural.h"
+
+/**
+ * \brief Montgomery arithmetic modulo an odd natural number m of n limbs, with R = 2^(64 * n).
+ * A residue x is stored as x * R mod m in n limbs, so that a product only needs a Montgomery reduction
+ * (multiplications by limbs and shifts by whole limbs) instead of a division by m.
+ */
+class Montgomery {
+public:
+    typedef natural::limb_type                      limb_type;
+    typedef natural::size_type                      size_type;
+    typedef natural::container_type                 container_type;
+
+    /// Constructors ///
+    // throws std::domain_error if the modulus is even or 0
+    explicit Montgomery(const container_type& modulus) noexcept(false);
+
+    /// Utility ///
+    inline size_type size() const { return n; }
+    inline const container_type& modulus() const { return m; }
+
+    /// Conversion ///
+    // a * R mod m in n limbs, for a of any size
+    container_type to_montgomery(const container_type& a) const;
+    // x / R mod m as a natural number without leading zero limbs
+    container_type from_montgomery(const container_type& x) const;
+    // R mod m, the representation of 1
+    inline const container_type& one() const { return r1; }
+
+    /// Arithmetic ///
+    // r = a + b mod m and r = a - b mod m on n limbs each, for a and b below m. r may equal a or b
+    void add(limb_type* r, const limb_type* a, const limb_type* b) const;
+    void sub(limb_type* r, const limb_type* a, const limb_type* b) const;
+    // r = a * b / R mod m on n limbs each. r may equal a or b, scratch must hold 2 * n limbs
+    void mul(limb_type* r, const limb_type* a, const limb_type* b, limb_type* scratch) const;
+    container_type mul(const container_type& a, const container_type& b) const;
+    // r = a * a / R mod m, with the same requirements as mul
+    inline void sqr(limb_type* r, const limb_type* a, limb_type* scratch) const { mul(r, a, a, scratch); }
+    // x^e for x in Montgomery form and a natural exponent e
+    container_type pow(const container_type& x, const container_type& e) const;
+    // r = x^-1 for x in Montgomery form, returns false if x is not invertible
+    bool inverse(container_type& r, const container_type& x) const;
+
+private:
+    container_type m;
+    size_type n;
+    limb_type minv; // -m^-1 mod 2^64
+    container_type r1; // R mod m
+    container_type r2; // R^2 mod m
+
+    void redc(limb_type* r, limb_type* t) const;
+
+};
+
+
+#endif //LMPA_LIBRARY_MONTGOMERY_H
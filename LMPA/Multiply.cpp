@@ -0,0 +1,170 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Kernels.h"
+#include "ThreadPool.h"
+#include "Thresholds.h"
+
+#include <vector> // temporaries
+#include <algorithm> // swap, fill
+
+using kernels::limb_type;
+using kernels::size_type;
+using kernels::container_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    /**
+     * \brief r = a + b for an >= bn, returns the carry out. r must hold an limbs.
+     */
+    limb_type add(limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn) {
+        limb_type carry = kernels::add_n(r, a, b, bn);
+        for (size_type i = bn; i < an; ++i) {
+            r[i] = a[i] + carry;
+            carry = r[i] < carry;
+        }
+        return carry;
+    }
+
+    /**
+     * \brief a -= b for an >= bn, returns the borrow out.
+     */
+    limb_type sub_in_place(limb_type* a, size_type an, const limb_type* b, size_type bn) {
+        limb_type borrow = kernels::sub_n(a, a, b, bn);
+        for (size_type i = bn; i < an && borrow; ++i) {
+            borrow = a[i] == 0;
+            --a[i];
+        }
+        return borrow;
+    }
+
+    void mul_rec(limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn, ThreadPool* pool);
+    void sqr_rec(limb_type* r, const limb_type* a, size_type n, ThreadPool* pool);
+
+    /**
+     * \brief r = a * b for two operands of n limbs each.
+     * With a = a1 * B^h + a0 and b = b1 * B^h + b0, the middle product a0 * b1 + a1 * b0 is
+     * (a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1, which saves one of the four half-size products.
+     * The three products are independent of each other and run on the pool for large n.
+     */
+    void karatsuba(limb_type* r, const limb_type* a, const limb_type* b, size_type n, ThreadPool* pool) {
+        const size_type h = n / 2;
+        const size_type hh = n - h; // size of the high halves, h or h + 1
+
+        container_type sa(hh + 1), sb(hh + 1), mid(2 * hh + 2);
+        sa[hh] = add(sa.data(), a + h, hh, a, h);
+        sb[hh] = add(sb.data(), b + h, hh, b, h);
+
+        // a0 * b0 and a1 * b1 go directly into the low and high half of r
+        if (pool && n >= thresholds::get().parallel_mul) {
+            ThreadPool::TaskGroup halves(*pool);
+            halves.submit([=] { mul_rec(r, a, h, b, h, pool); });
+            halves.submit([=] { mul_rec(r + 2 * h, a + h, hh, b + h, hh, pool); });
+            mul_rec(mid.data(), sa.data(), hh + 1, sb.data(), hh + 1, pool);
+            halves.wait();
+        } else {
+            mul_rec(r, a, h, b, h, pool);
+            mul_rec(r + 2 * h, a + h, hh, b + h, hh, pool);
+            mul_rec(mid.data(), sa.data(), hh + 1, sb.data(), hh + 1, pool);
+        }
+
+        sub_in_place(mid.data(), mid.size(), r, 2 * h);
+        sub_in_place(mid.data(), mid.size(), r + 2 * h, 2 * hh);
+
+        // the middle product is less than B^(2 * n - h), so the addition cannot carry out of r
+        add(r + h, r + h, 2 * n - h, mid.data(), mid.size());
+    }
+
+    /**
+     * \brief r = a * a for an operand of n limbs, see karatsuba. All three half-size products are squares.
+     */
+    void karatsuba_sqr(limb_type* r, const limb_type* a, size_type n, ThreadPool* pool) {
+        const size_type h = n / 2;
+        const size_type hh = n - h;
+
+        container_type sa(hh + 1), mid(2 * hh + 2);
+        sa[hh] = add(sa.data(), a + h, hh, a, h);
+
+        if (pool && n >= thresholds::get().parallel_mul) {
+            ThreadPool::TaskGroup halves(*pool);
+            halves.submit([=] { sqr_rec(r, a, h, pool); });
+            halves.submit([=] { sqr_rec(r + 2 * h, a + h, hh, pool); });
+            sqr_rec(mid.data(), sa.data(), hh + 1, pool);
+            halves.wait();
+        } else {
+            sqr_rec(r, a, h, pool);
+            sqr_rec(r + 2 * h, a + h, hh, pool);
+            sqr_rec(mid.data(), sa.data(), hh + 1, pool);
+        }
+
+        sub_in_place(mid.data(), mid.size(), r, 2 * h);
+        sub_in_place(mid.data(), mid.size(), r + 2 * h, 2 * hh);
+        add(r + h, r + h, 2 * n - h, mid.data(), mid.size());
+    }
+
+    /**
+     * \brief r = a * a for an operand of any size.
+     */
+    void sqr_rec(limb_type* r, const limb_type* a, size_type n, ThreadPool* pool) {
+        if (n < thresholds::get().karatsuba_sqr) {
+            kernels::sqr_basecase(r, a, n);
+        } else {
+            karatsuba_sqr(r, a, n, pool);
+        }
+    }
+
+    /**
+     * \brief r = a * b for operands of any size.
+     */
+    void mul_rec(limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn, ThreadPool* pool) {
+        if (an < bn) {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+
+        if (bn < thresholds::get().karatsuba_mul) {
+            kernels::mul_basecase(r, a, an, b, bn);
+            return;
+        }
+
+        if (an == bn) {
+            karatsuba(r, a, b, an, pool);
+            return;
+        }
+
+        // unbalanced: multiply b with slices of bn limbs of a and accumulate
+        std::fill(r, r + an + bn, 0);
+        container_type temp(2 * bn);
+        for (size_type i = 0; i < an; i += bn) {
+            const size_type slice = std::min(bn, an - i);
+            mul_rec(temp.data(), a + i, slice, b, bn, pool);
+            add(r + i, r + i, an + bn - i, temp.data(), slice + bn);
+        }
+    }
+}
+
+
+/// Multiplication ///
+
+/**
+ * \brief r = a * b for operands of any size, with basecase or Karatsuba multiplication depending on their sizes.
+ * Identical operands are squared instead. The result does not depend on whether or how many threads are used.
+ */
+void kernels::mul(limb_type* r, const limb_type* a, size_type an, const limb_type* b, size_type bn,
+                  ThreadPool* pool) {
+    if (a == b && an == bn) {
+        sqr_rec(r, a, an, pool);
+        return;
+    }
+    mul_rec(r, a, an, b, bn, pool);
+}
+
+/**
+ * \brief r = a * a, with basecase or Karatsuba squaring depending on the size of a.
+ */
+void kernels::sqr(limb_type* r, const limb_type* a, size_type n, ThreadPool* pool) {
+    sqr_rec(r, a, n, pool);
+}
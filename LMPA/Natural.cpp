@@ -0,0 +1,340 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Natural.h"
+#include "Binary.h" // div_by_zero_error
+#include "Thresholds.h"
+
+#include <algorithm> // min
+#include <cmath> // log2, exp2, ldexp
+
+using natural::limb_type;
+using natural::size_type;
+using natural::container_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    // Hensel's division halves the quotient from this many times the Karatsuba threshold of divisor limbs on.
+    // The products of the halves are about twice as long as the part needed, so it pays off only late
+    constexpr size_type hensel_karatsuba_factor = 32;
+
+    // r[0, n) -= b[0, m) modulo 2^(64 n) for m <= n
+    void sub_low(limb_type* r, size_type n, const limb_type* b, size_type m) {
+        limb_type borrow = kernels::sub_n(r, r, b, m);
+        for (size_type i = m; i < n && borrow; ++i) {
+            borrow = r[i] == 0;
+            --r[i];
+        }
+    }
+
+    /**
+     * \brief Hensel's division of the n limbs of r by the odd d from the low end, one quotient limb at a time:
+     * with minv = -d[0]^-1, adding r[i] * minv * d clears limb i of r, as in Montgomery's reduction.
+     * The added multiples sum up to -q, as r + (-q) * d = 0 modulo 2^(64 n). Overwrites r.
+     */
+    void hensel_basecase(limb_type* q, limb_type* r, size_type n, const limb_type* d, size_type dn, limb_type minv) {
+        for (size_type i = 0; i < n; ++i) {
+            q[i] = r[i] * minv;
+            const size_type m = std::min(dn, n - i);
+            limb_type carry = kernels::addmul_1(r + i, d, m, q[i]);
+            for (size_type j = i + m; j < n && carry; ++j) {
+                r[j] += carry;
+                carry = r[j] < carry;
+            }
+        }
+        bool borrow = false;
+        for (size_type i = 0; i < n; ++i) {
+            const limb_type negated = 0 - q[i] - borrow;
+            borrow = borrow || q[i] != 0;
+            q[i] = negated;
+        }
+    }
+
+    /**
+     * \brief q = r / d modulo 2^(64 n), divide and conquer: the low half of the quotient from the low half of r,
+     * then its product with d is subtracted from the high half of r, which gives the high half of the quotient.
+     * The products are plain multiplications, taking the pool along, so that the division costs a few of them.
+     * Overwrites r.
+     */
+    void hensel(limb_type* q, limb_type* r, size_type n, const limb_type* d, size_type dn, limb_type minv,
+                ThreadPool* pool) {
+        // limbs of d above n do not affect the result
+        dn = std::min(dn, n);
+        if (dn < hensel_karatsuba_factor * thresholds::get().karatsuba_mul) {
+            hensel_basecase(q, r, n, d, dn, minv);
+            return;
+        }
+        const size_type low = n / 2;
+        hensel(q, r, low, d, dn, minv, pool);
+        container_type product(low + dn);
+        kernels::mul(product.data(), d, dn, q, low, pool);
+        sub_low(r + low, n - low, product.data() + low, std::min(dn, n - low));
+        hensel(q + low, r + low, n - low, d, dn, minv, pool);
+    }
+}
+
+
+/// Utility ///
+
+void natural::normalize(container_type& a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+container_type natural::from_limb(limb_type x) {
+    return x ? container_type(1, x) : container_type();
+}
+
+size_type natural::bit_length(const container_type& a) {
+    if (a.empty()) { return 0; }
+    size_type bits = (a.size() - 1) * kernels::limb_bits;
+    for (limb_type top = a.back(); top; top >>= 1) { ++bits; }
+    return bits;
+}
+
+bool natural::bit(const container_type& a, size_type i) {
+    const size_type limb = i / kernels::limb_bits;
+    return limb < a.size() && ((a[limb] >> (i % kernels::limb_bits)) & 1);
+}
+
+bool natural::any_below(const container_type& a, size_type n) {
+    const size_type limbs = std::min(n / kernels::limb_bits, a.size());
+    for (size_type i = 0; i < limbs; ++i) {
+        if (a[i]) { return true; }
+    }
+    if (limbs < a.size() && n % kernels::limb_bits) {
+        return (a[limbs] << (kernels::limb_bits - n % kernels::limb_bits)) != 0;
+    }
+    return false;
+}
+
+double natural::log2(const container_type& a) {
+    const size_type bits = bit_length(a);
+    if (bits <= kernels::limb_bits) { return std::log2(static_cast<double>(a[0])); }
+    const size_type shift = bits - kernels::limb_bits;
+    const size_type i = shift / kernels::limb_bits, s = shift % kernels::limb_bits;
+    const limb_type top = s ? (a[i] >> s) | (a[i + 1] << (kernels::limb_bits - s)) : a[i];
+    return static_cast<double>(shift) + std::log2(static_cast<double>(top));
+}
+
+
+/// Comparison ///
+
+/**
+ * \brief Returns -1, 0 or 1 if a is less than, equal to or greater than b.
+ */
+int natural::compare(const container_type& a, const container_type& b) {
+    if (a.size() != b.size()) { return a.size() < b.size() ? -1 : 1; }
+    for (size_type i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) { return a[i] < b[i] ? -1 : 1; }
+    }
+    return 0;
+}
+
+
+/// Arithmetic ///
+
+container_type natural::add(const container_type& a, const container_type& b) {
+    if (a.size() < b.size()) { return add(b, a); }
+    container_type result(a.size() + 1);
+    limb_type carry = kernels::add_n(result.data(), a.data(), b.data(), b.size());
+    for (size_type i = b.size(); i < a.size(); ++i) {
+        result[i] = a[i] + carry;
+        carry = result[i] < carry;
+    }
+    result[a.size()] = carry;
+    normalize(result);
+    return result;
+}
+
+container_type natural::sub(const container_type& a, const container_type& b) {
+    container_type result(a.size());
+    limb_type borrow = kernels::sub_n(result.data(), a.data(), b.data(), b.size());
+    for (size_type i = b.size(); i < a.size(); ++i) {
+        result[i] = a[i] - borrow;
+        borrow = borrow && a[i] == 0;
+    }
+    normalize(result);
+    return result;
+}
+
+container_type natural::mul(const container_type& a, const container_type& b, ThreadPool* pool) {
+    if (a.empty() || b.empty()) { return container_type(); }
+    container_type result(a.size() + b.size());
+    kernels::mul(result.data(), a.data(), a.size(), b.data(), b.size(), pool);
+    normalize(result);
+    return result;
+}
+
+container_type natural::shl(const container_type& a, size_type n) {
+    if (a.empty()) { return container_type(); }
+    const size_type limbs = n / kernels::limb_bits;
+    const unsigned bits = static_cast<unsigned>(n % kernels::limb_bits);
+    container_type result(limbs, 0);
+    result.insert(std::end(result), std::begin(a), std::end(a));
+    if (bits) {
+        result.emplace_back(kernels::lshift(result.data() + limbs, result.data() + limbs, a.size(), bits));
+        normalize(result);
+    }
+    return result;
+}
+
+container_type natural::shr(const container_type& a, size_type n) {
+    const size_type limbs = n / kernels::limb_bits;
+    if (limbs >= a.size()) { return container_type(); }
+    const unsigned bits = static_cast<unsigned>(n % kernels::limb_bits);
+    container_type result(std::begin(a) + limbs, std::end(a));
+    if (bits) {
+        kernels::rshift(result.data(), result.data(), result.size(), bits);
+        normalize(result);
+    }
+    return result;
+}
+
+/**
+ * \brief q = a / b and r = a % b.
+ */
+void natural::divrem(const container_type& a, const container_type& b, container_type& q, container_type& r)
+        noexcept(false) {
+    if (b.empty()) {
+        throw div_by_zero_error();
+    }
+    if (compare(a, b) < 0) {
+        q.clear();
+        r = a;
+        return;
+    }
+
+    q.assign(a.size() - b.size() + 1, 0);
+    r.assign(b.size(), 0);
+    kernels::divrem(q.data(), r.data(), a.data(), a.size(), b.data(), b.size());
+    normalize(q);
+    normalize(r);
+}
+
+/**
+ * \brief Exact division from the low end (Jebelean, An exact division algorithm, 1993). Common trailing zeros are
+ * shifted out to make the divisor odd, then the quotient is a / b modulo the power of two of its size, computed by
+ * Hensel's division. Costs about as much as multiplying the quotient by b, without any division or normalization.
+ */
+container_type natural::divexact(const container_type& a, const container_type& b, ThreadPool* pool)
+        noexcept(false) {
+    if (b.empty()) {
+        throw div_by_zero_error();
+    }
+    size_type zeros = 0;
+    while (!bit(b, zeros)) { ++zeros; }
+    container_type r = shr(a, zeros);
+    const container_type d = shr(b, zeros);
+    if (r.size() < d.size()) { return container_type(); }
+
+    // the quotient fits into this many limbs, so only as many limbs of a and b take part
+    const size_type n = r.size() - d.size() + 1;
+    limb_type inverse = d[0];
+    for (int i = 0; i < 5; ++i) {
+        // Newton's iteration doubles the correct low bits of the inverse, d[0] itself is correct to 3 bits
+        inverse *= 2 - d[0] * inverse;
+    }
+    container_type q(n);
+    hensel(q.data(), r.data(), n, d.data(), d.size(), ~inverse + 1, pool);
+    normalize(q);
+    return q;
+}
+
+/**
+ * \brief a^e by square and multiply from the top bit of e.
+ */
+container_type natural::pow(const container_type& a, std::uint64_t e) {
+    container_type result = from_limb(1);
+    size_type i = kernels::limb_bits;
+    while (i > 0 && !((e >> (i - 1)) & 1)) { --i; }
+    while (i-- > 0) {
+        result = mul(result, result);
+        if ((e >> i) & 1) { result = mul(result, a); }
+    }
+    return result;
+}
+
+container_type natural::sqrt(const container_type& a) {
+    container_type s, r;
+    sqrtrem(a, s, r);
+    return s;
+}
+
+/**
+ * \brief Square root with precision doubling: the root of the top half of a, shifted back, is above the root of a
+ * by at most 2^(e / 2), so that one Newton step x = (x + a / x) / 2 leaves it at most 1 above the root.
+ * Each level thus costs one division of the full size by half the size and one squaring,
+ * and the levels below it together cost about as much as it does.
+ */
+void natural::sqrtrem(const container_type& a, container_type& s, container_type& r) {
+    const size_type bits = bit_length(a);
+    if (bits <= 2 * kernels::limb_bits) {
+        // Newton's iteration, starting above the root so that it decreases monotonically
+        s = a.empty() ? container_type() : shl(from_limb(1), (bits + 1) / 2);
+        while (!s.empty()) {
+            container_type q, rem;
+            divrem(a, s, q, rem);
+            container_type y = shr(add(s, q), 1);
+            if (compare(y, s) >= 0) { break; }
+            s = std::move(y);
+        }
+    } else {
+        // e is even and at most (bits - 1) / 2
+        const size_type e = 2 * ((bits - 1) / 4);
+        container_type top, rem;
+        sqrtrem(shr(a, e), top, rem);
+        const container_type x = shl(add(top, from_limb(1)), e / 2);
+        container_type q;
+        divrem(a, x, q, rem);
+        s = shr(add(x, q), 1);
+    }
+
+    container_type square = mul(s, s);
+    while (compare(square, a) > 0) {
+        // (s - 1)^2 = s^2 - (2 s - 1)
+        square = sub(square, sub(shl(s, 1), from_limb(1)));
+        s = sub(s, from_limb(1));
+    }
+    r = sub(a, square);
+}
+
+/**
+ * \brief nth root with precision doubling like sqrtrem: the root of a shifted by n * m bits, shifted back by m,
+ * starts Newton's iteration x = ((n - 1) * x + a / x^(n - 1)) / n close above the root. Roots of up to 64 bits
+ * start from the floating point root instead, raised by its error bound, as Newton's iteration only gains
+ * a factor of about (n - 1) / n per step while far above the root.
+ */
+container_type natural::root(const container_type& a, size_type n) {
+    if (n == 1 || a.empty()) { return a; }
+    if (n == 2) { return sqrt(a); }
+
+    const size_type bits = bit_length(a);
+    if (bits <= n) { return from_limb(1); }
+
+    // the root is below 2^root_bits
+    const size_type root_bits = (bits + n - 1) / n;
+    container_type x;
+    if (root_bits <= kernels::limb_bits) {
+        // the rounding errors of log2 and exp2 stay below 2^-44 relative for roots of up to 64 bits
+        const double estimate = std::exp2(log2(a) / static_cast<double>(n)) * (1 + std::ldexp(1.0, -40)) + 1;
+        x = estimate < std::ldexp(1.0, static_cast<int>(root_bits))
+            ? from_limb(static_cast<limb_type>(estimate)) : shl(from_limb(1), root_bits);
+    } else {
+        const size_type m = root_bits / 2;
+        x = shl(add(root(shr(a, n * m), n), from_limb(1)), m);
+    }
+
+    const container_type divisor = from_limb(n), factor = from_limb(n - 1);
+    while (true) {
+        container_type q, r, y;
+        divrem(a, pow(x, n - 1), q, r);
+        divrem(add(mul(x, factor), q), divisor, y, r);
+        if (compare(y, x) >= 0) { return x; }
+        x = std::move(y);
+    }
+}
@@ -0,0 +1,61 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_NATURAL_H
+#define LMPA_LIBRARY_NATURAL_H
+
+#include <vector> // container
+#include <cstdint> // uint64_t
+
+#include "Kernels.h"
+
+class ThreadPool;
+
+/**
+ * \brief Arithmetic on natural numbers stored as little-endian limbs without leading zero limbs,
+ * an empty container being 0. Used where Binary's fixed precision is in the way, e.g. for exact intermediate results.
+ */
+namespace natural {
+
+    typedef kernels::limb_type                      limb_type;
+    typedef kernels::size_type                      size_type;
+    typedef kernels::container_type                 container_type;
+
+    /// Utility ///
+    void normalize(container_type& a); // removes leading zero limbs
+    container_type from_limb(limb_type x);
+    size_type bit_length(const container_type& a);
+    bool bit(const container_type& a, size_type i);
+    // true if any of the lowest n bits is set
+    bool any_below(const container_type& a, size_type n);
+    // binary logarithm of a nonzero a from its top 64 bits, accurate to about 2^-52 relative
+    double log2(const container_type& a);
+
+    /// Comparison ///
+    int compare(const container_type& a, const container_type& b);
+
+    /// Arithmetic ///
+    container_type add(const container_type& a, const container_type& b);
+    // requires a >= b
+    container_type sub(const container_type& a, const container_type& b);
+    container_type mul(const container_type& a, const container_type& b, ThreadPool* pool = nullptr);
+    container_type shl(const container_type& a, size_type n);
+    container_type shr(const container_type& a, size_type n);
+    // throws div_by_zero_error if b is 0
+    void divrem(const container_type& a, const container_type& b, container_type& q, container_type& r) noexcept(false);
+    // a / b if b divides a, unspecified otherwise. Throws div_by_zero_error if b is 0
+    container_type divexact(const container_type& a, const container_type& b, ThreadPool* pool = nullptr)
+            noexcept(false);
+    container_type pow(const container_type& a, std::uint64_t e);
+    // floor of the square root
+    container_type sqrt(const container_type& a);
+    // s = floor of the square root, r = a - s^2
+    void sqrtrem(const container_type& a, container_type& s, container_type& r);
+    // floor of the nth root for n > 0
+    container_type root(const container_type& a, size_type n);
+
+}
+
+
+#endif //LMPA_LIBRARY_NATURAL_H
@@ -0,0 +1,205 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Powers.h"
+#include "Natural.h"
+
+#include <limits> // size_type maximum
+#include <stdexcept> // domain_error, length_error
+
+using kernels::limb_type;
+typedef Binary::limb_container limb_container;
+typedef Binary::size_type size_type;
+
+/**
+ * \brief Locally used functions and variables.
+ * Values are unsigned little-endian limbs without leading zero limbs, an empty container being 0.
+ */
+namespace {
+    constexpr size_type unlimited = std::numeric_limits<size_type>::max();
+
+    using kernels::limbs_for;
+
+    /**
+     * \brief Window size for an exponent of the given bits. Larger windows save multiplications,
+     * but need 2^(k - 1) precomputed odd powers.
+     */
+    unsigned window_for(size_type bits) {
+        const size_type limits[] = {7, 25, 81, 241, 673, 1793};
+        unsigned k = 1;
+        for (const size_type limit : limits) {
+            if (bits <= limit) { break; }
+            ++k;
+        }
+        return k;
+    }
+
+    /**
+     * \brief Number of limbs of the lowest cap limbs of x, without leading zero limbs.
+     */
+    size_type trim(const limb_type* x, size_type n, size_type cap) {
+        n = std::min(n, cap);
+        while (n > 0 && x[n - 1] == 0) { --n; }
+        return n;
+    }
+
+    /**
+     * \brief m^e modulo B^cap for m > 1 and e > 0, by left-to-right sliding window exponentiation:
+     * the exponent is scanned from the top, zero bits square the result, and runs of up to k bits ending
+     * in a one square it once per bit and then multiply by one of the precomputed odd powers m^1, m^3, ...
+     * Both result buffers are allocated once with the size of the exact result, or twice the cap.
+     */
+    limb_container power(const limb_container& m, const limb_container& e, size_type cap) {
+        const size_type ebits = natural::bit_length(e);
+        const unsigned k = window_for(ebits);
+
+        // m^e < 2^(e * bits of m), and every intermediate product is at most one limb larger than its value
+        const size_type mbits = natural::bit_length(m);
+        size_type size = unlimited;
+        if (e.size() == 1 && e[0] <= (unlimited - kernels::limb_bits) / mbits) {
+            size = limbs_for(mbits * e[0]) + 1;
+        }
+        if (cap <= unlimited / 2) {
+            size = std::min(size, 2 * cap);
+        }
+        if (size == unlimited) {
+            throw std::length_error("Power too large to be represented.");
+        }
+
+        std::vector<limb_container> odd(size_type(1) << (k - 1));
+        odd[0] = m;
+        odd[0].resize(trim(m.data(), m.size(), cap));
+        if (k > 1) {
+            limb_container m2 = natural::mul(odd[0], odd[0]);
+            m2.resize(trim(m2.data(), m2.size(), cap));
+            for (size_type i = 1; i < odd.size(); ++i) {
+                odd[i] = natural::mul(odd[i - 1], m2);
+                odd[i].resize(trim(odd[i].data(), odd[i].size(), cap));
+            }
+        }
+
+        limb_container x(size), t(size);
+        size_type xn = 0;
+        auto square = [&] {
+            kernels::sqr(t.data(), x.data(), xn);
+            xn = trim(t.data(), 2 * xn, cap);
+            std::swap(x, t);
+        };
+        auto mul_by = [&](const limb_container& p) {
+            if (p.empty()) {
+                xn = 0;
+                return;
+            }
+            kernels::mul(t.data(), x.data(), xn, p.data(), p.size());
+            xn = trim(t.data(), xn + p.size(), cap);
+            std::swap(x, t);
+        };
+
+        for (size_type i = ebits; i > 0;) {
+            if (xn > 0 && !natural::bit(e, i - 1)) {
+                square();
+                if (xn == 0) {
+                    // wrapped around to 0
+                    return limb_container();
+                }
+                --i;
+                continue;
+            }
+
+            // the longest window of at most k bits from bit i - 1 downward that ends in a one
+            size_type j = i > k ? i - k : 0;
+            while (!natural::bit(e, j)) { ++j; }
+            size_type value = 0;
+            for (size_type b = i; b-- > j;) {
+                value = (value << 1) | natural::bit(e, b);
+            }
+            const limb_container& p = odd[value >> 1];
+
+            if (xn == 0) {
+                // the top window
+                std::copy(std::begin(p), std::end(p), std::begin(x));
+                xn = p.size();
+            } else {
+                for (size_type s = i - j; s > 0 && xn > 0; --s) { square(); }
+                if (xn > 0) { mul_by(p); }
+            }
+            if (xn == 0) {
+                // wrapped around to 0
+                return limb_container();
+            }
+            i = j;
+        }
+
+        x.resize(xn);
+        return x;
+    }
+
+    /**
+     * \brief base^e for the exponent as limbs.
+     */
+    Binary pow_of(const Binary& base, const limb_container& e) {
+        const bool dynamic = base.storage_type == Binary::StorageType::Dynamic;
+        const size_type prec = base.precision();
+        const size_type cap = dynamic ? unlimited : limbs_for(prec);
+        const limb_container m = base.magnitude();
+        const bool negative = base.sign() && natural::bit(e, 0);
+
+        limb_container magnitude;
+        if (e.empty()) {
+            magnitude = natural::from_limb(1);
+        } else if (m.empty() || natural::bit_length(m) == 1) {
+            // 0^e and 1^e
+            magnitude = m;
+        } else if (!natural::any_below(m, natural::bit_length(m) - 1)) {
+            // a power of two is a shift
+            const size_type shift = natural::bit_length(m) - 1;
+            if (e.size() == 1 && e[0] <= unlimited / shift) {
+                const size_type bits = shift * e[0];
+                if (dynamic || bits < cap * kernels::limb_bits) {
+                    magnitude = natural::shl(natural::from_limb(1), bits);
+                }
+            } else if (dynamic) {
+                throw std::length_error("Power too large to be represented.");
+            }
+        } else {
+            magnitude = power(m, e, cap);
+        }
+
+        if (!dynamic) {
+            magnitude.resize(std::min(magnitude.size(), cap));
+            Binary result = Binary::from_magnitude(magnitude, negative, prec);
+            result.set_precision(prec);
+            return result;
+        }
+
+        // like dynamic multiplication, only grow if necessary and then in whole limbs
+        Binary result = Binary::from_magnitude(magnitude, negative, prec);
+        if (result.precision() > prec) {
+            result.set_precision(limbs_for(result.precision()) * kernels::limb_bits);
+        }
+        result.storage_type = Binary::StorageType::Dynamic;
+        return result;
+    }
+}
+
+
+/// Powers ///
+
+/**
+ * \brief base^exponent by sliding window exponentiation on the squaring kernels.
+ * Powers of two are computed as a shift.
+ */
+Binary pow(const Binary& base, std::uint64_t exponent) {
+    return pow_of(base, natural::from_limb(exponent));
+}
+
+/**
+ * \brief base^exponent for an arbitrary precision exponent. Throws std::domain_error if the exponent is negative.
+ */
+Binary pow(const Binary& base, const Binary& exponent) noexcept(false) {
+    if (exponent.sign()) {
+        throw std::domain_error("Negative exponent given to pow.");
+    }
+    return pow_of(base, exponent.magnitude());
+}
@@ -0,0 +1,21 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_POWERS_H
+#define LMPA_LIBRARY_POWERS_H
+
+#include <cstdint> // uint64_t
+
+#include "Binary.h"
+
+/// Powers ///
+// results have the precision of the base and wrap around like multiplication,
+// unless the base is dynamic, in which case they grow to hold the exact value. 0^0 is 1
+
+Binary pow(const Binary& base, std::uint64_t exponent);
+// throws std::domain_error if the exponent is negative
+Binary pow(const Binary& base, const Binary& exponent) noexcept(false);
+
+
+#endif //LMPA_LIBRARY_POWERS_H
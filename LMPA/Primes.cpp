@@ -0,0 +1,287 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Primes.h"
+#include "Natural.h"
+#include "Montgomery.h"
+#include "ThreadPool.h"
+#include "DivisorU64.h"
+
+#include <algorithm> // binary_search
+#include <limits> // numeric_limits
+#include <random> // mt19937_64
+
+using kernels::limb_type;
+typedef Binary::limb_container limb_container;
+typedef Binary::size_type size_type;
+
+/**
+ * \brief Locally used functions and variables.
+ * Values are unsigned little-endian limbs without leading zero limbs, an empty container being 0.
+ */
+namespace {
+    // trial division uses the primes below this bound, so survivors below its square are prime
+    constexpr limb_type trial_bound = 1024;
+
+    // the Miller-Rabin bases deterministic for all values below 3.3 * 10^24
+    constexpr limb_type deterministic_bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+    // candidates per task batch of next_prime on a pool, per thread
+    constexpr size_type batch_per_thread = 2;
+
+    /**
+     * \brief The primes below trial_bound, grouped into runs whose products fit into a limb,
+     * so that a remainder modulo a whole group costs one pass over the value.
+     */
+    struct SmallPrimes {
+        struct Group {
+            size_type begin, end;
+            limb_type product;
+        };
+
+        std::vector<limb_type> primes;
+        std::vector<Group> groups;
+        // the products of the groups with their reciprocals
+        std::vector<DivisorU64> divisors;
+
+        SmallPrimes() {
+            std::vector<bool> composite(trial_bound, false);
+            for (limb_type i = 2; i < trial_bound; ++i) {
+                if (composite[i]) { continue; }
+                primes.emplace_back(i);
+                for (limb_type j = i * i; j < trial_bound; j += i) {
+                    composite[j] = true;
+                }
+            }
+
+            Group group{0, 0, 1};
+            for (size_type i = 0; i < primes.size(); ++i) {
+                if (group.product > std::numeric_limits<limb_type>::max() / primes[i]) {
+                    groups.emplace_back(group);
+                    group = Group{i, i, 1};
+                }
+                group.product *= primes[i];
+                group.end = i + 1;
+            }
+            groups.emplace_back(group);
+            for (const Group& g : groups) {
+                divisors.emplace_back(g.product);
+            }
+        }
+    };
+
+    const SmallPrimes& small_primes() {
+        static const SmallPrimes table;
+        return table;
+    }
+
+    /**
+     * \brief a mod p for all small primes p, from one single-limb remainder of a per group of primes,
+     * computed with the group's precomputed reciprocal.
+     */
+    std::vector<limb_type> residues(const limb_container& a) {
+        const SmallPrimes& table = small_primes();
+        std::vector<limb_type> result(table.primes.size(), 0);
+        for (size_type g = 0; g < table.groups.size(); ++g) {
+            const SmallPrimes::Group& group = table.groups[g];
+            const limb_type r = table.divisors[g].mod(a.data(), a.size());
+            for (size_type i = group.begin; i < group.end; ++i) {
+                result[i] = r % table.primes[i];
+            }
+        }
+        return result;
+    }
+
+    bool below_trial_square(const limb_container& a) {
+        return a.size() == 1 && a[0] < trial_bound * trial_bound;
+    }
+
+    /**
+     * \brief One Miller-Rabin round for a - 1 = d * 2^s: true if base^d = 1 or base^(d * 2^i) = -1 modulo a
+     * for some i < s, with all values in Montgomery form.
+     */
+    bool strong_probable_prime(const Montgomery& mont, const limb_container& d, size_type s,
+                               const limb_container& minus_one, const limb_container& base) {
+        limb_container x = mont.pow(mont.to_montgomery(base), d);
+        if (x == mont.one() || x == minus_one) { return true; }
+
+        limb_container scratch(2 * mont.size());
+        for (size_type i = 1; i < s; ++i) {
+            mont.mul(x.data(), x.data(), x.data(), scratch.data());
+            if (x == minus_one) { return true; }
+            if (x == mont.one()) { return false; }
+        }
+        return false;
+    }
+
+    /**
+     * \brief Miller-Rabin test of an odd a above trial_bound^2. The pseudorandom bases are seeded
+     * from a, so that the result for a value does not change between calls.
+     */
+    bool miller_rabin(const limb_container& a, unsigned rounds) {
+        const Montgomery mont(a);
+        const limb_container a_minus_one = natural::sub(a, natural::from_limb(1));
+        size_type s = 0;
+        while (!natural::bit(a_minus_one, s)) { ++s; }
+        const limb_container d = natural::shr(a_minus_one, s);
+        const limb_container minus_one = mont.to_montgomery(a_minus_one);
+
+        if (a.size() == 1) {
+            for (const limb_type base : deterministic_bases) {
+                if (!strong_probable_prime(mont, d, s, minus_one, natural::from_limb(base))) { return false; }
+            }
+            return true;
+        }
+
+        if (!strong_probable_prime(mont, d, s, minus_one, natural::from_limb(2))) { return false; }
+
+        // further bases uniformly in [2, a - 2]
+        std::mt19937_64 engine(a[0]);
+        const limb_container range = natural::sub(a, natural::from_limb(3));
+        for (unsigned round = 1; round < rounds; ++round) {
+            limb_container x(a.size());
+            for (limb_type& limb : x) { limb = engine(); }
+            natural::normalize(x);
+            limb_container q, r;
+            natural::divrem(x, range, q, r);
+            if (!strong_probable_prime(mont, d, s, minus_one, natural::add(r, natural::from_limb(2)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool probable_prime(const limb_container& a, unsigned rounds) {
+        if (a.size() == 1 && a[0] < trial_bound) {
+            const std::vector<limb_type>& primes = small_primes().primes;
+            return std::binary_search(std::begin(primes), std::end(primes), a[0]);
+        }
+        for (const limb_type r : residues(a)) {
+            if (r == 0) { return false; }
+        }
+        return below_trial_square(a) || miller_rabin(a, rounds);
+    }
+
+    /**
+     * \brief Odd candidates from a start upwards without a small prime factor. The residues modulo the
+     * small primes are computed once and advanced by 2 per candidate, so rejected candidates cost
+     * no arithmetic on the full value.
+     */
+    class Candidates {
+    public:
+        explicit Candidates(const limb_container& start) : value(start), remainders(residues(start)) {}
+
+        limb_container next() {
+            const std::vector<limb_type>& primes = small_primes().primes;
+            while (true) {
+                bool survives = true;
+                for (size_type i = 0; i < primes.size() && survives; ++i) {
+                    // a small prime itself survives its own division
+                    survives = remainders[i] != 0 || (value.size() == 1 && value[0] == primes[i]);
+                }
+                limb_container candidate = value;
+                advance();
+                if (survives) { return candidate; }
+            }
+        }
+
+    private:
+        limb_container value;
+        std::vector<limb_type> remainders;
+
+        void advance() {
+            const std::vector<limb_type>& primes = small_primes().primes;
+            value = natural::add(value, natural::from_limb(2));
+            for (size_type i = 0; i < primes.size(); ++i) {
+                remainders[i] = (remainders[i] + 2) % primes[i];
+            }
+        }
+    };
+
+    // a candidate without small prime factors is prime below trial_bound^2
+    bool screened_prime(const limb_container& candidate, unsigned rounds) {
+        return below_trial_square(candidate) || miller_rabin(candidate, rounds);
+    }
+
+    // the first odd value above n, or 2 for n < 2
+    limb_container first_candidate(const Binary& n) {
+        if (n.sign()) { return natural::from_limb(2); }
+        const limb_container magnitude = n.magnitude();
+        if (natural::compare(magnitude, natural::from_limb(2)) < 0) { return natural::from_limb(2); }
+        return natural::add(magnitude, natural::from_limb(natural::bit(magnitude, 0) ? 2 : 1));
+    }
+
+    Binary from_prime(const limb_container& magnitude, const Binary& n) {
+        Binary result = Binary::from_magnitude(magnitude, false, n.precision());
+        result.storage_type = n.storage_type;
+        return result;
+    }
+}
+
+
+/// Primality ///
+
+/**
+ * \brief Trial division with single-limb remainders, then Miller-Rabin. Composites are never reported prime
+ * below 2^64, above the chance of a composite passing is at most 4^-rounds.
+ */
+bool is_probable_prime(const Binary& n, unsigned rounds) {
+    return !n.sign() && probable_prime(n.magnitude(), rounds);
+}
+
+/**
+ * \brief Tests every candidate as a task on the pool.
+ */
+std::vector<bool> is_probable_prime(const std::vector<Binary>& candidates, ThreadPool& pool, unsigned rounds) {
+    // one byte per result, as tasks must not share the words of a vector<bool>
+    std::vector<char> results(candidates.size(), 0);
+    ThreadPool::TaskGroup tasks(pool);
+    tasks.reserve(candidates.size());
+    for (size_type i = 0; i < candidates.size(); ++i) {
+        tasks.submit([&, i] { results[i] = is_probable_prime(candidates[i], rounds); });
+    }
+    tasks.wait();
+    return std::vector<bool>(std::begin(results), std::end(results));
+}
+
+/**
+ * \brief Walks the odd values above n, sieved incrementally by the small primes,
+ * and returns the first survivor passing Miller-Rabin.
+ */
+Binary next_prime(const Binary& n, unsigned rounds) {
+    const limb_container start = first_candidate(n);
+    if (start == natural::from_limb(2)) { return from_prime(start, n); }
+
+    Candidates candidates(start);
+    while (true) {
+        const limb_container candidate = candidates.next();
+        if (screened_prime(candidate, rounds)) { return from_prime(candidate, n); }
+    }
+}
+
+/**
+ * \brief Like next_prime, but the survivors of the sieve are tested in batches of a few per thread,
+ * of which the smallest prime is returned.
+ */
+Binary next_prime(const Binary& n, ThreadPool& pool, unsigned rounds) {
+    const limb_container start = first_candidate(n);
+    if (start == natural::from_limb(2)) { return from_prime(start, n); }
+
+    Candidates candidates(start);
+    const size_type batch = batch_per_thread * std::max<size_type>(pool.size(), 1);
+    while (true) {
+        std::vector<limb_container> values(batch);
+        std::vector<char> results(batch, 0);
+        ThreadPool::TaskGroup tasks(pool);
+        tasks.reserve(batch);
+        for (size_type i = 0; i < batch; ++i) {
+            values[i] = candidates.next();
+            tasks.submit([&, i] { results[i] = screened_prime(values[i], rounds); });
+        }
+        tasks.wait();
+        for (size_type i = 0; i < batch; ++i) {
+            if (results[i]) { return from_prime(values[i], n); }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_PRIMES_H
+#define LMPA_LIBRARY_PRIMES_H
+
+#include <vector> // container
+
+#include "Binary.h"
+
+class ThreadPool;
+
+/// Primality ///
+// trial division by the primes below 1024, then Miller-Rabin in Montgomery form with base 2 and rounds - 1
+// pseudorandom bases, or the twelve prime bases up to 37 below 2^64 where they are deterministic.
+// Values below 2 are not prime
+
+bool is_probable_prime(const Binary& n, unsigned rounds = 25);
+// screens all candidates, distributed over the pool
+std::vector<bool> is_probable_prime(const std::vector<Binary>& candidates, ThreadPool& pool, unsigned rounds = 25);
+
+// the smallest probable prime greater than n, with at least the precision of n
+Binary next_prime(const Binary& n, unsigned rounds = 25);
+// tests the candidates surviving trial division in batches on the pool
+Binary next_prime(const Binary& n, ThreadPool& pool, unsigned rounds = 25);
+
+
+#endif //LMPA_LIBRARY_PRIMES_H
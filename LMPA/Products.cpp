@@ -0,0 +1,222 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Products.h"
+#include "ThreadPool.h"
+#include "Thresholds.h"
+
+#include <limits> // limb maximum
+
+using kernels::limb_type;
+typedef Binary::limb_container limb_container;
+typedef Binary::size_type size_type;
+
+/**
+ * \brief Locally used functions and variables.
+ * Values are unsigned little-endian limbs without leading zero limbs, an empty container being 0.
+ */
+namespace {
+    // below this, factorial multiplies the numbers directly instead of recursing
+    constexpr std::uint64_t small_factorial = 32;
+
+    limb_container multiply(const limb_container& a, const limb_container& b, ThreadPool* pool) {
+        if (a.empty() || b.empty()) { return limb_container(); }
+        limb_container result(a.size() + b.size());
+        kernels::mul(result.data(), a.data(), a.size(), b.data(), b.size(), pool);
+        if (result.back() == 0) { result.pop_back(); }
+        return result;
+    }
+
+    /**
+     * \brief Multiplies the leaves in [lo, hi) as a balanced tree, so that all multiplications
+     * at one level have operands of similar size. prefix[i] is the number of limbs in the first i leaves.
+     */
+    limb_container tree(const std::vector<limb_container>& leaves, const std::vector<size_type>& prefix,
+                        size_type lo, size_type hi, ThreadPool* pool) {
+        if (hi - lo == 1) { return leaves[lo]; }
+
+        const size_type mid = lo + (hi - lo) / 2;
+        limb_container left, right;
+        if (pool && prefix[hi] - prefix[lo] >= thresholds::get().parallel_product) {
+            ThreadPool::TaskGroup task(*pool);
+            task.submit([&] { left = tree(leaves, prefix, lo, mid, pool); });
+            right = tree(leaves, prefix, mid, hi, pool);
+            task.wait();
+        } else {
+            left = tree(leaves, prefix, lo, mid, pool);
+            right = tree(leaves, prefix, mid, hi, pool);
+        }
+        return multiply(left, right, pool);
+    }
+
+    limb_container tree(const std::vector<limb_container>& leaves, ThreadPool* pool) {
+        if (leaves.empty()) { return limb_container(1, 1); }
+        std::vector<size_type> prefix(leaves.size() + 1, 0);
+        for (size_type i = 0; i < leaves.size(); ++i) {
+            prefix[i + 1] = prefix[i] + leaves[i].size();
+        }
+        return tree(leaves, prefix, 0, leaves.size(), pool);
+    }
+
+    /**
+     * \brief Packs single-limb factors into as few single-limb leaves as possible.
+     */
+    std::vector<limb_container> pack(const std::vector<limb_type>& factors) {
+        std::vector<limb_container> leaves;
+        limb_type current = 1;
+        for (const limb_type f : factors) {
+            if (current > std::numeric_limits<limb_type>::max() / f) {
+                leaves.emplace_back(1, current);
+                current = 1;
+            }
+            current *= f;
+        }
+        if (current != 1 || leaves.empty()) {
+            leaves.emplace_back(1, current);
+        }
+        return leaves;
+    }
+
+    std::vector<std::uint64_t> primes_up_to(std::uint64_t n) {
+        std::vector<std::uint64_t> primes;
+        if (n < 2) { return primes; }
+        std::vector<bool> composite(n + 1, false);
+        for (std::uint64_t i = 2; i <= n; ++i) {
+            if (composite[i]) { continue; }
+            primes.emplace_back(i);
+            for (std::uint64_t j = i * i; j <= n; j += i) {
+                composite[j] = true;
+            }
+        }
+        return primes;
+    }
+
+    /**
+     * \brief The swinging factorial n!/(floor(n/2)!)^2. Prime p divides it exactly
+     * sum_i (floor(n/p^i) mod 2) times, and each of these prime powers is at most n.
+     */
+    limb_container swing(std::uint64_t n, const std::vector<std::uint64_t>& primes, ThreadPool* pool) {
+        std::vector<limb_type> factors;
+        for (const std::uint64_t p : primes) {
+            if (p > n) { break; }
+            limb_type power = 1;
+            for (std::uint64_t q = n / p; q > 0; q /= p) {
+                if (q & 1) { power *= p; }
+            }
+            if (power > 1) { factors.emplace_back(power); }
+        }
+        return tree(pack(factors), pool);
+    }
+
+    /**
+     * \brief n! = (floor(n/2)!)^2 * swing(n). The swing runs on the pool while the recursion continues.
+     */
+    limb_container factorial_of(std::uint64_t n, const std::vector<std::uint64_t>& primes, ThreadPool* pool) {
+        if (n < small_factorial) {
+            std::vector<limb_type> factors;
+            for (std::uint64_t i = 2; i <= n; ++i) { factors.emplace_back(i); }
+            return tree(pack(factors), pool);
+        }
+
+        limb_container sw;
+        limb_container half;
+        if (pool) {
+            ThreadPool::TaskGroup task(*pool);
+            task.submit([&] { sw = swing(n, primes, pool); });
+            half = factorial_of(n / 2, primes, pool);
+            task.wait();
+        } else {
+            sw = swing(n, primes, pool);
+            half = factorial_of(n / 2, primes, pool);
+        }
+        return multiply(multiply(half, half, pool), sw, pool);
+    }
+
+    Binary product_of(const std::vector<Binary>& factors, ThreadPool* pool) {
+        size_type prec = 1;
+        bool negative = false;
+        std::vector<limb_container> leaves;
+        leaves.reserve(factors.size());
+        for (const Binary& b : factors) {
+            prec = std::max(prec, b.precision());
+            negative ^= b.sign();
+            leaves.emplace_back(b.magnitude());
+            if (leaves.back().empty()) {
+                return Binary(prec);
+            }
+        }
+        return Binary::from_magnitude(tree(leaves, pool), negative, prec);
+    }
+
+    Binary factorial_of(std::uint64_t n, ThreadPool* pool) {
+        const std::vector<std::uint64_t> primes = primes_up_to(n);
+        return Binary::from_magnitude(factorial_of(n, primes, pool), false);
+    }
+
+    /**
+     * \brief By Kummer's theorem, prime p divides (n choose k) once per borrow when subtracting k from n in base p.
+     * Each of the resulting prime powers is at most n.
+     */
+    Binary binomial_of(std::uint64_t n, std::uint64_t k, ThreadPool* pool) {
+        if (k > n) { return Binary(); }
+        k = std::min(k, n - k);
+
+        std::vector<limb_type> factors;
+        for (const std::uint64_t p : primes_up_to(n)) {
+            limb_type power = 1;
+            std::uint64_t borrow = 0;
+            for (std::uint64_t nn = n, kk = k; nn > 0; nn /= p, kk /= p) {
+                borrow = (nn % p) < (kk % p) + borrow;
+                if (borrow) { power *= p; }
+            }
+            if (power > 1) { factors.emplace_back(power); }
+        }
+        return Binary::from_magnitude(tree(pack(factors), pool), false);
+    }
+}
+
+
+/// Products ///
+
+/**
+ * \brief Product of all factors, multiplied as a balanced product tree.
+ */
+Binary product(const std::vector<Binary>& factors) {
+    return product_of(factors, nullptr);
+}
+
+/**
+ * \brief Product of all factors, with independent subtrees multiplied on the pool.
+ */
+Binary product(const std::vector<Binary>& factors, ThreadPool& pool) {
+    return product_of(factors, &pool);
+}
+
+/**
+ * \brief n!, computed with the prime swing algorithm.
+ */
+Binary factorial(std::uint64_t n) {
+    return factorial_of(n, nullptr);
+}
+
+/**
+ * \brief n!, computed with the prime swing algorithm on the pool.
+ */
+Binary factorial(std::uint64_t n, ThreadPool& pool) {
+    return factorial_of(n, &pool);
+}
+
+/**
+ * \brief The binomial coefficient (n choose k), computed from its prime factorization. 0 if k > n.
+ */
+Binary binomial(std::uint64_t n, std::uint64_t k) {
+    return binomial_of(n, k, nullptr);
+}
+
+/**
+ * \brief The binomial coefficient (n choose k), with the product tree multiplied on the pool.
+ */
+Binary binomial(std::uint64_t n, std::uint64_t k, ThreadPool& pool) {
+    return binomial_of(n, k, &pool);
+}
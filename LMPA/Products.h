@@ -0,0 +1,45 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_PRODUCTS_H
+#define LMPA_LIBRARY_PRODUCTS_H
+
+#include <vector> // container
+#include <cstdint> // uint64_t
+
+#include "Binary.h"
+
+class ThreadPool;
+
+/// Products ///
+// all results are exact, their precision is the smallest one holding the value,
+// but at least that of the largest factor (product) or 32 bits (factorial, binomial)
+
+Binary product(const std::vector<Binary>& factors);
+Binary product(const std::vector<Binary>& factors, ThreadPool& pool);
+
+/**
+ * \brief Product of all Binaries in [first, last), multiplied as a balanced product tree.
+ */
+template<typename Iterator>
+Binary product(Iterator first, Iterator last) {
+    return product(std::vector<Binary>(first, last));
+}
+
+/**
+ * \brief Product of all Binaries in [first, last), with independent subtrees multiplied on the pool.
+ */
+template<typename Iterator>
+Binary product(Iterator first, Iterator last, ThreadPool& pool) {
+    return product(std::vector<Binary>(first, last), pool);
+}
+
+Binary factorial(std::uint64_t n);
+Binary factorial(std::uint64_t n, ThreadPool& pool);
+
+Binary binomial(std::uint64_t n, std::uint64_t k);
+Binary binomial(std::uint64_t n, std::uint64_t k, ThreadPool& pool);
+
+
+#endif //LMPA_LIBRARY_PRODUCTS_H
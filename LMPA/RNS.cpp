@@ -0,0 +1,283 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "RNS.h"
+#include "Natural.h"
+#include "Primes.h"
+#include "ThreadPool.h"
+
+#include <algorithm> // sort, adjacent_find, min
+#include <stdexcept> // domain_error
+
+typedef RNSBasis::limb_type limb_type;
+typedef RNSBasis::size_type size_type;
+typedef RNSBasis::container_type container_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    // residue operations per task, below a slice is not worth handing to the pool
+    constexpr size_type slice_operations = 4096;
+
+    /**
+     * \brief Calls function(begin, end) on slices of [0, n) of at least min_slice each, one per thread of the pool.
+     */
+    template<typename Function>
+    void for_slices(size_type n, size_type min_slice, ThreadPool* pool, Function function) {
+        const size_type slices = pool ? std::min<size_type>(pool->size(), n / std::max<size_type>(min_slice, 1)) : 1;
+        if (slices < 2) {
+            function(size_type(0), n);
+            return;
+        }
+        ThreadPool::TaskGroup tasks(*pool);
+        tasks.reserve(slices);
+        for (size_type s = 0; s < slices; ++s) {
+            const size_type begin = n * s / slices, end = n * (s + 1) / slices;
+            tasks.submit([&function, begin, end] { function(begin, end); });
+        }
+        tasks.wait();
+    }
+
+    // (a * b + c) mod d
+    inline limb_type muladd_mod(const DivisorU64& d, limb_type a, limb_type b, limb_type c) {
+        limb_type t[2];
+        t[0] = kernels::mul_ll(a, b, t[1]);
+        t[0] += c;
+        t[1] += t[0] < c;
+        return d.mod(t, 2);
+    }
+
+    struct Add {
+        limb_type operator()(const RNSBasis& basis, size_type i, limb_type a, limb_type b) const { return basis.add(i, a, b); }
+    };
+
+    struct Subtract {
+        limb_type operator()(const RNSBasis& basis, size_type i, limb_type a, limb_type b) const { return basis.sub(i, a, b); }
+    };
+
+    struct Multiply {
+        limb_type operator()(const RNSBasis& basis, size_type i, limb_type a, limb_type b) const { return basis.mul(i, a, b); }
+    };
+}
+
+
+/// Constructors ///
+
+/**
+ * \brief Checks the primes and precomputes the constants of Garner's conversion, the inverses of the products
+ * of all preceding primes, by Fermat's little theorem.
+ */
+RNSBasis::RNSBasis(const container_type& primes) noexcept(false) : p(primes) {
+    container_type sorted = p;
+    std::sort(std::begin(sorted), std::end(sorted));
+    if (p.empty() || std::adjacent_find(std::begin(sorted), std::end(sorted)) != std::end(sorted)) {
+        throw std::domain_error("A residue number system requires distinct primes.");
+    }
+    for (const limb_type prime : p) {
+        if (!is_probable_prime(Binary::from_magnitude(natural::from_limb(prime), false))) {
+            throw std::domain_error("A residue number system requires distinct primes.");
+        }
+        divisors.emplace_back(prime);
+    }
+
+    garner.assign(p.size(), 1);
+    for (size_type i = 1; i < p.size(); ++i) {
+        limb_type product = 1;
+        for (size_type j = 0; j < i; ++j) {
+            product = muladd_mod(divisors[i], product, p[j], 0);
+        }
+        // product^(p_i - 2) = product^-1 mod p_i
+        limb_type inverse = 1;
+        for (limb_type e = p[i] - 2, base = product; e; e >>= 1) {
+            if (e & 1) { inverse = mul(i, inverse, base); }
+            base = mul(i, base, base);
+        }
+        garner[i] = inverse;
+    }
+
+    M = natural::from_limb(1);
+    for (const limb_type prime : p) {
+        M.emplace_back(kernels::mul_1(M.data(), M.data(), M.size(), prime));
+        natural::normalize(M);
+    }
+    half = natural::shr(M, 1);
+}
+
+/**
+ * \brief Walks down the odd values from 2^64 - 1 until the product of the primes found holds the precision.
+ */
+std::shared_ptr<const RNSBasis> RNSBasis::with_precision(size_type precision) {
+    container_type primes;
+    container_type product = natural::from_limb(1);
+    for (limb_type candidate = ~limb_type(0); natural::bit_length(product) < precision + 2; candidate -= 2) {
+        if (is_probable_prime(Binary::from_magnitude(natural::from_limb(candidate), false))) {
+            primes.emplace_back(candidate);
+            product.emplace_back(kernels::mul_1(product.data(), product.data(), product.size(), candidate));
+        }
+    }
+    return std::make_shared<const RNSBasis>(primes);
+}
+
+
+/// Utility ///
+
+/**
+ * \brief A precision P holds values down to -2^(P - 1), which (-M / 2, M / 2] contains for 2^P <= M - 2.
+ */
+size_type RNSBasis::capacity() const {
+    if (natural::compare(M, natural::from_limb(2)) <= 0) { return 0; }
+    return natural::bit_length(natural::sub(M, natural::from_limb(2))) - 1;
+}
+
+
+/// Conversion ///
+
+container_type RNSBasis::residues(const Binary& a, ThreadPool* pool) const {
+    const container_type magnitude = a.magnitude();
+    const bool negative = a.sign();
+    container_type result(p.size());
+    for_slices(p.size(), slice_operations / std::max<size_type>(magnitude.size(), 1), pool,
+               [&](size_type begin, size_type end) {
+        for (size_type i = begin; i < end; ++i) {
+            const limb_type r = divisors[i].mod(magnitude.data(), magnitude.size());
+            result[i] = negative && r ? p[i] - r : r;
+        }
+    });
+    return result;
+}
+
+/**
+ * \brief Garner's algorithm: the digits v_i of x = v_0 + p_0 * (v_1 + p_1 * (v_2 + ..)) follow one after the other
+ * from v_i = (r_i - (v_0 + .. + p_0 * .. * p_(i-2) * v_(i-1))) * (p_0 * .. * p_(i-1))^-1 mod p_i, with word operations
+ * only. The digits then give x by Horner's scheme, and x above M / 2 stands for x - M.
+ */
+Binary RNSBasis::reconstruct(const container_type& residues) const {
+    const size_type k = p.size();
+    container_type v(k);
+    for (size_type i = 0; i < k; ++i) {
+        limb_type s = 0;
+        if (i) {
+            s = divisors[i].mod(&v[i - 1], 1);
+            for (size_type j = i - 1; j-- > 0;) {
+                s = muladd_mod(divisors[i], s, p[j], v[j]);
+            }
+        }
+        v[i] = mul(i, sub(i, residues[i], s), garner[i]);
+    }
+
+    container_type x = natural::from_limb(v[k - 1]);
+    for (size_type i = k - 1; i-- > 0;) {
+        x.emplace_back(kernels::mul_1(x.data(), x.data(), x.size(), p[i]));
+        limb_type carry = v[i];
+        for (size_type j = 0; j < x.size() && carry; ++j) {
+            x[j] += carry;
+            carry = x[j] < carry;
+        }
+        natural::normalize(x);
+    }
+
+    if (natural::compare(x, half) > 0) {
+        return Binary::from_magnitude(natural::sub(M, x), true);
+    }
+    return Binary::from_magnitude(x, false);
+}
+
+
+/// Constructors ///
+
+RNSBinary::RNSBinary(const Binary& a, basis_type basis) : b(std::move(basis)), r(b->residues(a)) {}
+
+RNSBinary::RNSBinary(const Binary& a, basis_type basis, ThreadPool& pool) : b(std::move(basis)), r(b->residues(a, &pool)) {}
+
+
+/// Utility ///
+
+Binary RNSBinary::to_binary() const {
+    return b->reconstruct(r);
+}
+
+void RNSBinary::check(const RNSBinary& other) const noexcept(false) {
+    if (b != other.b && b->primes() != other.b->primes()) {
+        throw std::domain_error("Residues of different bases.");
+    }
+}
+
+template<typename Operation>
+RNSBinary RNSBinary::apply(const RNSBinary& x, const RNSBinary& y, Operation operation, ThreadPool* pool) noexcept(false) {
+    x.check(y);
+    const RNSBasis& basis = *x.b;
+    container_type result(basis.size());
+    for_slices(basis.size(), slice_operations, pool, [&](size_type begin, size_type end) {
+        for (size_type i = begin; i < end; ++i) {
+            result[i] = operation(basis, i, x.r[i], y.r[i]);
+        }
+    });
+    return RNSBinary(x.b, std::move(result));
+}
+
+
+/// Assignment Operators ///
+
+RNSBinary& RNSBinary::operator+=(const RNSBinary& other) noexcept(false) {
+    return *this = apply(*this, other, Add(), nullptr);
+}
+
+RNSBinary& RNSBinary::operator-=(const RNSBinary& other) noexcept(false) {
+    return *this = apply(*this, other, Subtract(), nullptr);
+}
+
+RNSBinary& RNSBinary::operator*=(const RNSBinary& other) noexcept(false) {
+    return *this = apply(*this, other, Multiply(), nullptr);
+}
+
+
+/// Arithmetic Operators ///
+
+RNSBinary RNSBinary::operator+(const RNSBinary& other) const noexcept(false) {
+    return apply(*this, other, Add(), nullptr);
+}
+
+RNSBinary RNSBinary::operator-(const RNSBinary& other) const noexcept(false) {
+    return apply(*this, other, Subtract(), nullptr);
+}
+
+RNSBinary RNSBinary::operator*(const RNSBinary& other) const noexcept(false) {
+    return apply(*this, other, Multiply(), nullptr);
+}
+
+RNSBinary RNSBinary::operator-() const {
+    container_type result(r.size());
+    for (size_type i = 0; i < r.size(); ++i) {
+        result[i] = b->sub(i, 0, r[i]);
+    }
+    return RNSBinary(b, std::move(result));
+}
+
+
+/// Comparison Operators ///
+
+bool RNSBinary::operator==(const RNSBinary& other) const noexcept(false) {
+    check(other);
+    return r == other.r;
+}
+
+bool RNSBinary::operator!=(const RNSBinary& other) const noexcept(false) {
+    return !(*this == other);
+}
+
+
+/// Parallel Arithmetic ///
+
+RNSBinary add(const RNSBinary& x, const RNSBinary& y, ThreadPool& pool) noexcept(false) {
+    return RNSBinary::apply(x, y, Add(), &pool);
+}
+
+RNSBinary subtract(const RNSBinary& x, const RNSBinary& y, ThreadPool& pool) noexcept(false) {
+    return RNSBinary::apply(x, y, Subtract(), &pool);
+}
+
+RNSBinary multiply(const RNSBinary& x, const RNSBinary& y, ThreadPool& pool) noexcept(false) {
+    return RNSBinary::apply(x, y, Multiply(), &pool);
+}
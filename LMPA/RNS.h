@@ -0,0 +1,141 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_RNS_H
+#define LMPA_LIBRARY_RNS_H
+
+#include <vector> // residues
+#include <memory> // shared_ptr
+
+#include "Binary.h"
+#include "DivisorU64.h"
+
+class ThreadPool;
+
+/**
+ * \brief A residue number system: pairwise distinct word-size primes p_0 .. p_(k-1) with product M. Integers in
+ * (-M / 2, M / 2] are represented exactly by their residues modulo every prime, so that additions, subtractions and
+ * multiplications are k independent word operations without carries between them. Results outside the range
+ * wrap modulo M.
+ */
+class RNSBasis {
+public:
+    typedef kernels::limb_type                      limb_type;
+    typedef kernels::size_type                      size_type;
+    typedef kernels::container_type                 container_type;
+
+    /// Constructors ///
+    // throws std::domain_error if a value is not prime, repeated, or if there is none
+    explicit RNSBasis(const container_type& primes) noexcept(false);
+    // the largest primes below 2^64 that represent all values of the given precision, including the sign
+    static std::shared_ptr<const RNSBasis> with_precision(size_type precision);
+
+    /// Utility ///
+    inline size_type size() const { return p.size(); }
+    inline const container_type& primes() const { return p; }
+    inline const DivisorU64& divisor(size_type i) const { return divisors[i]; }
+    // M as a natural number
+    inline const container_type& product() const { return M; }
+    // the largest precision whose values are represented exactly
+    size_type capacity() const;
+
+    /// Arithmetic ///
+    // a + b, a - b and a * b modulo the ith prime, for a and b below it
+    inline limb_type add(size_type i, limb_type a, limb_type b) const {
+        const limb_type s = a + b;
+        return s < a || s >= p[i] ? s - p[i] : s;
+    }
+    inline limb_type sub(size_type i, limb_type a, limb_type b) const {
+        return a < b ? a - b + p[i] : a - b;
+    }
+    inline limb_type mul(size_type i, limb_type a, limb_type b) const {
+        limb_type hi;
+        const limb_type lo = kernels::mul_ll(a, b, hi);
+        return divisors[i].mod(hi, lo);
+    }
+
+    /// Conversion ///
+    // the residues of a modulo every prime, the products of a slice of the primes being computed on the pool
+    container_type residues(const Binary& a, ThreadPool* pool = nullptr) const;
+    // the value in (-M / 2, M / 2] of the residues, by Garner's mixed radix conversion
+    Binary reconstruct(const container_type& residues) const;
+
+private:
+    container_type p;
+    std::vector<DivisorU64> divisors;
+    container_type garner; // (p_0 * .. * p_(i-1))^-1 mod p_i
+    container_type M;
+    container_type half; // M / 2
+
+};
+
+
+/**
+ * \brief An integer as its residues in a residue number system. Sums, differences and products never carry
+ * from one residue into the next, so their loops vectorize and split across threads. Only to_binary() reconstructs
+ * the integer. Operations on values of different bases throw std::domain_error.
+ */
+class RNSBinary {
+public:
+    typedef RNSBasis::limb_type                     limb_type;
+    typedef RNSBasis::size_type                     size_type;
+    typedef RNSBasis::container_type                container_type;
+    typedef std::shared_ptr<const RNSBasis>         basis_type;
+
+    /// Constructors ///
+    RNSBinary(const Binary& a, basis_type basis);
+    RNSBinary(const Binary& a, basis_type basis, ThreadPool& pool);
+
+    RNSBinary(const RNSBinary& other) = default;
+    RNSBinary(RNSBinary&& other) = default;
+
+    ~RNSBinary() = default;
+
+    /// Utility ///
+    inline const basis_type& basis() const { return b; }
+    inline const container_type& residues() const { return r; }
+    // the value modulo M in (-M / 2, M / 2]
+    Binary to_binary() const;
+
+    /// Assignment Operators ///
+    RNSBinary& operator=(const RNSBinary& other) = default;
+    RNSBinary& operator=(RNSBinary&& other) = default;
+    RNSBinary& operator+=(const RNSBinary& other) noexcept(false);
+    RNSBinary& operator-=(const RNSBinary& other) noexcept(false);
+    RNSBinary& operator*=(const RNSBinary& other) noexcept(false);
+
+    /// Arithmetic Operators ///
+    RNSBinary operator+(const RNSBinary& other) const noexcept(false);
+    RNSBinary operator-(const RNSBinary& other) const noexcept(false);
+    RNSBinary operator*(const RNSBinary& other) const noexcept(false);
+    RNSBinary operator-() const;
+
+    /// Comparison Operators ///
+    // equality modulo M, ordering needs to_binary()
+    bool operator==(const RNSBinary& other) const noexcept(false);
+    bool operator!=(const RNSBinary& other) const noexcept(false);
+
+    friend RNSBinary add(const RNSBinary& x, const RNSBinary& y, ThreadPool& pool) noexcept(false);
+    friend RNSBinary subtract(const RNSBinary& x, const RNSBinary& y, ThreadPool& pool) noexcept(false);
+    friend RNSBinary multiply(const RNSBinary& x, const RNSBinary& y, ThreadPool& pool) noexcept(false);
+
+private:
+    basis_type b;
+    container_type r;
+
+    RNSBinary(basis_type basis, container_type residues) : b(std::move(basis)), r(std::move(residues)) {}
+    void check(const RNSBinary& other) const noexcept(false);
+    template<typename Operation>
+    static RNSBinary apply(const RNSBinary& x, const RNSBinary& y, Operation operation, ThreadPool* pool) noexcept(false);
+
+};
+
+/// Parallel Arithmetic ///
+// the same results as x + y, x - y and x * y, with slices of the residues computed on the pool
+RNSBinary add(const RNSBinary& x, const RNSBinary& y, ThreadPool& pool) noexcept(false);
+RNSBinary subtract(const RNSBinary& x, const RNSBinary& y, ThreadPool& pool) noexcept(false);
+RNSBinary multiply(const RNSBinary& x, const RNSBinary& y, ThreadPool& pool) noexcept(false);
+
+
+#endif //LMPA_LIBRARY_RNS_H
@@ -0,0 +1,158 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Roots.h"
+#include "Natural.h"
+#include "DivisorU64.h"
+
+#include <stdexcept> // domain_error
+#include <cmath> // exp2, round, fabs
+
+typedef Binary::limb_container limb_container;
+typedef Binary::size_type size_type;
+using kernels::limb_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+
+    Binary from_root(const limb_container& magnitude, bool negative, const Binary& a) {
+        Binary result = Binary::from_magnitude(magnitude, negative, a.precision());
+        result.storage_type = a.storage_type;
+        return result;
+    }
+
+    // number of trailing zero bits of a nonzero magnitude
+    size_type trailing_zeros(const limb_container& a) {
+        size_type zeros = 0;
+        while (!natural::bit(a, zeros)) { ++zeros; }
+        return zeros;
+    }
+
+    // primes q = 1 mod p a candidate pth power is tested modulo, each rejects all but one in p of the non-powers
+    constexpr size_type residue_filters = 4;
+    // roots of up to this many bits are told apart from non-integers by their floating point estimate
+    constexpr size_type float_root_bits = 32;
+
+    bool is_prime(size_type n) {
+        if (n < 2) { return false; }
+        for (size_type d = 2; d * d <= n; ++d) {
+            if (n % d == 0) { return false; }
+        }
+        return true;
+    }
+
+    // x^e mod d for x < d
+    limb_type pow_mod(limb_type x, limb_type e, const DivisorU64& d) {
+        limb_type result = 1, hi;
+        for (; e; e >>= 1) {
+            if (e & 1) {
+                const limb_type lo = kernels::mul_ll(result, x, hi);
+                result = d.mod(hi, lo);
+            }
+            const limb_type lo = kernels::mul_ll(x, x, hi);
+            x = d.mod(hi, lo);
+        }
+        return result;
+    }
+
+    // x^e mod 2^64, which the lowest limb of a pth power has to match
+    limb_type pow_low(limb_type x, limb_type e) {
+        limb_type result = 1;
+        for (; e; e >>= 1) {
+            if (e & 1) { result *= x; }
+            x *= x;
+        }
+        return result;
+    }
+
+    /**
+     * \brief False if a is certainly no pth power. Modulo a prime q = 1 mod p, the nonzero pth powers are
+     * the x with x^((q - 1) / p) = 1, one in p of the nonzero residues.
+     */
+    bool pth_power_residues(const limb_container& a, size_type p) {
+        size_type found = 0;
+        for (size_type q = 2 * p + 1; found < residue_filters; q += 2 * p) {
+            if (!is_prime(q)) { continue; }
+            ++found;
+            const DivisorU64 d(q);
+            const limb_type r = d.mod(a.data(), a.size());
+            if (r != 0 && pow_mod(r, (q - 1) / p, d) != 1) { return false; }
+        }
+        return true;
+    }
+
+    bool is_pth_power(const limb_container& a, const limb_container& root, size_type p) {
+        return pow_low(root[0], p) == a[0] && natural::compare(natural::pow(root, p), a) == 0;
+    }
+}
+
+
+/// Roots ///
+
+/**
+ * \brief Floor of the square root, by Newton's method with precision doubling. Throws for negative values.
+ */
+Binary isqrt(const Binary& a) noexcept(false) {
+    if (a.sign()) {
+        throw std::domain_error("Square root of a negative Binary.");
+    }
+    return from_root(natural::sqrt(a.magnitude()), false, a);
+}
+
+/**
+ * \brief Floor of the square root and the remainder a - root^2. Throws for negative values.
+ */
+void sqrtrem(const Binary& a, Binary& root, Binary& remainder) noexcept(false) {
+    if (a.sign()) {
+        throw std::domain_error("Square root of a negative Binary.");
+    }
+    limb_container s, r;
+    natural::sqrtrem(a.magnitude(), s, r);
+    root = from_root(s, false, a);
+    remainder = from_root(r, false, a);
+}
+
+/**
+ * \brief Floor of the nth root of |a|, negated for negative a, by Newton's method with precision doubling.
+ * Throws for n = 0 and for negative values if n is even.
+ */
+Binary iroot(const Binary& a, std::uint64_t n) noexcept(false) {
+    if (n == 0) {
+        throw std::domain_error("0th root of a Binary.");
+    }
+    if (a.sign() && n % 2 == 0) {
+        throw std::domain_error("Even root of a negative Binary.");
+    }
+    return from_root(natural::root(a.magnitude(), n), a.sign(), a);
+}
+
+/**
+ * \brief Tries all prime exponents p below the bit length, only those dividing the number of trailing zeros
+ * and odd ones for negative values. 0, 1 and -1 are perfect powers.
+ * Small roots are rounded from their floating point estimate, which has to be close to an integer, the others
+ * are computed only for the exponents passing the residue tests. Either root has to match the lowest limb
+ * of the magnitude when raised to the pth power modulo 2^64 before the power is computed in full.
+ */
+bool is_perfect_power(const Binary& a) {
+    const limb_container magnitude = a.magnitude();
+    const size_type bits = natural::bit_length(magnitude);
+    if (bits <= 1) { return true; }
+
+    const size_type zeros = trailing_zeros(magnitude);
+    const double log2 = natural::log2(magnitude);
+    for (size_type p = a.sign() ? 3 : 2; p < bits; ++p) {
+        if (!is_prime(p) || (zeros && zeros % p)) { continue; }
+        if ((bits + p - 1) / p <= float_root_bits) {
+            const double estimate = std::exp2(log2 / static_cast<double>(p)), rounded = std::round(estimate);
+            if (std::fabs(estimate - rounded) > 1.0 / 256) { continue; }
+            if (is_pth_power(magnitude, natural::from_limb(static_cast<limb_type>(rounded)), p)) { return true; }
+        } else if (pth_power_residues(magnitude, p)
+                   && is_pth_power(magnitude, natural::root(magnitude, p), p)) {
+            return true;
+        }
+    }
+    return false;
+}
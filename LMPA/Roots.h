@@ -0,0 +1,25 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_ROOTS_H
+#define LMPA_LIBRARY_ROOTS_H
+
+#include <cstdint> // uint64_t
+
+#include "Binary.h"
+
+/// Roots ///
+// results have the smallest precision holding them, but at least that of the argument
+
+// floor of the square root, throws std::domain_error for negative values
+Binary isqrt(const Binary& a) noexcept(false);
+// root = isqrt(a), remainder = a - root^2
+void sqrtrem(const Binary& a, Binary& root, Binary& remainder) noexcept(false);
+// floor of the nth root of |a| with the sign of a, throws std::domain_error for n = 0 and for negative values if n is even
+Binary iroot(const Binary& a, std::uint64_t n) noexcept(false);
+// true if a = b^k for some Binary b and k > 1
+bool is_perfect_power(const Binary& a);
+
+
+#endif //LMPA_LIBRARY_ROOTS_H
@@ -0,0 +1,136 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_SHAREDCONTAINER_H
+#define LMPA_LIBRARY_SHAREDCONTAINER_H
+
+#include <memory> // shared_ptr
+#include <atomic> // atomic_thread_fence
+#include <utility> // move, forward
+
+/**
+ * \brief A container that either owns its elements, like the container itself, or shares them with its copies
+ * through a reference count (copy-on-write). Shared elements are copied on the first write through a copy, so that
+ * copying is O(1) and reading never copies. Any number of threads may read and copy the same shared container,
+ * while each thread writes only to its own copies. The storage of the left-hand side of an assignment is kept.
+ */
+template<typename Container>
+class SharedContainer {
+public:
+    typedef Container                               container_type;
+    typedef typename Container::value_type          value_type;
+    typedef typename Container::size_type           size_type;
+    typedef typename Container::iterator            iterator;
+    typedef typename Container::const_iterator      const_iterator;
+
+    /// Constructors ///
+    SharedContainer() = default;
+    SharedContainer(size_type n, const value_type& value) : own(n, value) {}
+    explicit SharedContainer(const Container& c) : own(c) {}
+
+    SharedContainer(const SharedContainer& other) : own(other.shared ? Container() : other.own), shared(other.shared) {}
+    SharedContainer(SharedContainer&& other) = default;
+
+    ~SharedContainer() = default;
+
+    /// Storage ///
+    inline bool is_shared() const { return shared != nullptr; }
+
+    // moves the elements into shared storage
+    void share() {
+        if (shared) { return; }
+        shared = std::make_shared<Container>(std::move(own));
+        own = Container();
+    }
+
+    // moves or copies the elements back into owned storage
+    void unshare() {
+        if (!shared) { return; }
+        own = std::move(mutate_shared());
+        shared.reset();
+    }
+
+    /// Assignment ///
+    SharedContainer& operator=(const SharedContainer& other) {
+        if (this == &other) { return *this; }
+        if (!shared) {
+            own = other.get();
+        } else if (other.shared) {
+            shared = other.shared;
+        } else {
+            shared = std::make_shared<Container>(other.own);
+        }
+        return *this;
+    }
+
+    // may allocate: owned storage copies elements still shared with others, shared storage allocates for owned ones
+    SharedContainer& operator=(SharedContainer&& other) {
+        if (this == &other) { return *this; }
+        if (!shared) {
+            own = other.shared ? std::move(other.mutate_shared()) : std::move(other.own);
+            other.shared.reset();
+        } else if (other.shared) {
+            shared = std::move(other.shared);
+        } else {
+            shared = std::make_shared<Container>(std::move(other.own));
+        }
+        return *this;
+    }
+
+    SharedContainer& operator=(const Container& c) {
+        if (shared) { shared = std::make_shared<Container>(c); }
+        else { own = c; }
+        return *this;
+    }
+
+    /// Reading ///
+    inline const Container& get() const { return shared ? *shared : own; }
+    inline operator const Container&() const { return get(); }
+
+    inline const_iterator begin() const { return get().begin(); }
+    inline const_iterator end() const { return get().end(); }
+    inline size_type size() const { return get().size(); }
+    inline size_type capacity() const { return get().capacity(); }
+    inline bool empty() const { return get().empty(); }
+
+    /// Writing ///
+    // the elements for writing, copied first if another container shares them
+    inline Container& mutate() { return shared ? mutate_shared() : own; }
+
+    inline iterator begin() { return mutate().begin(); }
+    inline iterator end() { return mutate().end(); }
+
+    template<typename... Args>
+    iterator insert(const_iterator pos, Args&&... args) { return mutate().insert(pos, std::forward<Args>(args)...); }
+    iterator erase(const_iterator first, const_iterator last) { return mutate().erase(first, last); }
+    template<typename... Args>
+    void emplace_back(Args&&... args) { mutate().emplace_back(std::forward<Args>(args)...); }
+    void reserve(size_type n) { mutate().reserve(n); }
+    void resize(size_type n) { mutate().resize(n); }
+
+    // releases shared elements instead of copying them
+    void clear() {
+        if (shared && shared.use_count() != 1) { shared = std::make_shared<Container>(); }
+        else { mutate().clear(); }
+    }
+
+private:
+    Container own;
+    std::shared_ptr<Container> shared;
+
+    // a count of one means every other owner has released the elements, and the fence orders their last reads,
+    // which happened before their count decrement, before the writes that follow
+    Container& mutate_shared() {
+        if (shared.use_count() != 1) {
+            shared = std::make_shared<Container>(*shared);
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *shared;
+    }
+
+};
+
+
+#endif //LMPA_LIBRARY_SHAREDCONTAINER_H
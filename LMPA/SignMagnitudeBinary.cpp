@@ -0,0 +1,239 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "SignMagnitudeBinary.h"
+#include "Instrumentation.h"
+
+typedef SignMagnitudeBinary::limb_type limb_type;
+typedef SignMagnitudeBinary::size_type size_type;
+typedef SignMagnitudeBinary::container_type container_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    // two's complement negation of the limbs
+    void negate_limbs(container_type& limbs) {
+        bool carry = true;
+        for (limb_type& limb : limbs) {
+            limb = ~limb + carry;
+            carry = carry && limb == 0;
+        }
+    }
+
+    struct And {
+        limb_type operator()(limb_type a, limb_type b) const { return a & b; }
+    };
+
+    struct Or {
+        limb_type operator()(limb_type a, limb_type b) const { return a | b; }
+    };
+
+    struct Xor {
+        limb_type operator()(limb_type a, limb_type b) const { return a ^ b; }
+    };
+}
+
+
+/// Constructors ///
+
+SignMagnitudeBinary::SignMagnitudeBinary(const Binary& b) : mag(b.magnitude()), negative(b.sign()) {}
+
+SignMagnitudeBinary::SignMagnitudeBinary(container_type magnitude, bool is_negative) : mag(std::move(magnitude)) {
+    natural::normalize(mag);
+    negative = is_negative && !mag.empty();
+}
+
+
+/// Utility ///
+
+/**
+ * \brief One bit more than the magnitude, except for negative powers of two, whose sign bit is their top bit.
+ */
+size_type SignMagnitudeBinary::precision() const {
+    const size_type bits = natural::bit_length(mag);
+    if (negative && !natural::any_below(mag, bits - 1)) { return bits; }
+    return bits + 1;
+}
+
+Binary SignMagnitudeBinary::to_binary(size_type min_prec) const {
+    return Binary::from_magnitude(mag, negative, min_prec);
+}
+
+container_type SignMagnitudeBinary::twos_complement(size_type n) const {
+    container_type result(mag);
+    result.resize(n, 0);
+    if (negative) { negate_limbs(result); }
+    return result;
+}
+
+void SignMagnitudeBinary::assign_twos_complement(container_type limbs) {
+    negative = !limbs.empty() && (limbs.back() >> (kernels::limb_bits - 1));
+    if (negative) { negate_limbs(limbs); }
+    natural::normalize(limbs);
+    mag = std::move(limbs);
+}
+
+
+/// Assignment ///
+
+/**
+ * \brief Equal signs add the magnitudes, otherwise the smaller magnitude is subtracted from the larger,
+ * whose sign the result takes.
+ */
+void SignMagnitudeBinary::add_signed(const container_type& m, bool negative_m) {
+    if (negative == negative_m) {
+        mag = natural::add(mag, m);
+    } else if (natural::compare(mag, m) >= 0) {
+        mag = natural::sub(mag, m);
+    } else {
+        mag = natural::sub(m, mag);
+        negative = negative_m;
+    }
+    if (mag.empty()) { negative = false; }
+}
+
+SignMagnitudeBinary& SignMagnitudeBinary::operator+=(const SignMagnitudeBinary& other) {
+    LMPA_INSTRUMENT(Add, precision() + other.precision());
+    add_signed(other.mag, other.negative);
+    return *this;
+}
+
+SignMagnitudeBinary& SignMagnitudeBinary::operator-=(const SignMagnitudeBinary& other) {
+    LMPA_INSTRUMENT(Subtract, precision() + other.precision());
+    add_signed(other.mag, !other.negative && !other.mag.empty());
+    return *this;
+}
+
+SignMagnitudeBinary& SignMagnitudeBinary::operator*=(const SignMagnitudeBinary& other) {
+    return *this = *this * other;
+}
+
+SignMagnitudeBinary& SignMagnitudeBinary::operator/=(const SignMagnitudeBinary& other) noexcept(false) {
+    return *this = *this / other;
+}
+
+SignMagnitudeBinary& SignMagnitudeBinary::operator%=(const SignMagnitudeBinary& other) noexcept(false) {
+    return *this = *this % other;
+}
+
+SignMagnitudeBinary& SignMagnitudeBinary::operator<<=(size_type n) {
+    LMPA_INSTRUMENT(ShiftLeft, precision());
+    mag = natural::shl(mag, n);
+    return *this;
+}
+
+/**
+ * \brief Negative values shifted right round toward negative infinity, as if the two's complement was shifted:
+ * the magnitude grows by one if any bit was shifted out.
+ */
+SignMagnitudeBinary& SignMagnitudeBinary::operator>>=(size_type n) {
+    LMPA_INSTRUMENT(ShiftRight, precision());
+    const bool inexact = negative && natural::any_below(mag, n);
+    mag = natural::shr(mag, n);
+    if (inexact) { mag = natural::add(mag, natural::from_limb(1)); }
+    return *this;
+}
+
+/**
+ * \brief Applies the operation to the two's complement views, one limb wider than both magnitudes,
+ * so that the sign is in the top limb.
+ */
+template<typename Operation>
+SignMagnitudeBinary& SignMagnitudeBinary::bitwise(const SignMagnitudeBinary& other, Operation operation) {
+    const size_type n = std::max(mag.size(), other.mag.size()) + 1;
+    container_type left = twos_complement(n);
+    const container_type right = other.twos_complement(n);
+    for (size_type i = 0; i < n; ++i) {
+        left[i] = operation(left[i], right[i]);
+    }
+    assign_twos_complement(std::move(left));
+    return *this;
+}
+
+SignMagnitudeBinary& SignMagnitudeBinary::operator&=(const SignMagnitudeBinary& other) {
+    return bitwise(other, And());
+}
+
+SignMagnitudeBinary& SignMagnitudeBinary::operator|=(const SignMagnitudeBinary& other) {
+    return bitwise(other, Or());
+}
+
+SignMagnitudeBinary& SignMagnitudeBinary::operator^=(const SignMagnitudeBinary& other) {
+    return bitwise(other, Xor());
+}
+
+
+/// Arithmetic Operators ///
+
+SignMagnitudeBinary SignMagnitudeBinary::operator*(const SignMagnitudeBinary& other) const {
+    LMPA_INSTRUMENT(Multiply, precision() + other.precision());
+    return SignMagnitudeBinary(natural::mul(mag, other.mag), negative != other.negative);
+}
+
+SignMagnitudeBinary SignMagnitudeBinary::operator/(const SignMagnitudeBinary& other) const noexcept(false) {
+    LMPA_INSTRUMENT(Divide, precision() + other.precision());
+    container_type q, r;
+    natural::divrem(mag, other.mag, q, r);
+    return SignMagnitudeBinary(std::move(q), negative != other.negative);
+}
+
+SignMagnitudeBinary SignMagnitudeBinary::operator%(const SignMagnitudeBinary& other) const noexcept(false) {
+    LMPA_INSTRUMENT(Modulo, precision() + other.precision());
+    container_type q, r;
+    natural::divrem(mag, other.mag, q, r);
+    return SignMagnitudeBinary(std::move(r), negative);
+}
+
+SignMagnitudeBinary SignMagnitudeBinary::operator~() const {
+    SignMagnitudeBinary result = -*this;
+    result.add_signed(natural::from_limb(1), true);
+    return result;
+}
+
+
+/// Comparison Operators ///
+
+/**
+ * \brief Returns -1, 0 or 1 if this is less than, equal to or greater than other.
+ */
+int SignMagnitudeBinary::compare(const SignMagnitudeBinary& other) const {
+    LMPA_INSTRUMENT(Compare, precision() + other.precision());
+    if (negative != other.negative) { return negative ? -1 : 1; }
+    const int magnitudes = natural::compare(mag, other.mag);
+    return negative ? -magnitudes : magnitudes;
+}
+
+bool SignMagnitudeBinary::operator==(const SignMagnitudeBinary& other) const {
+    return negative == other.negative && mag == other.mag;
+}
+
+bool SignMagnitudeBinary::operator!=(const SignMagnitudeBinary& other) const {
+    return !(*this == other);
+}
+
+bool SignMagnitudeBinary::operator<(const SignMagnitudeBinary& other) const {
+    return compare(other) < 0;
+}
+
+bool SignMagnitudeBinary::operator>(const SignMagnitudeBinary& other) const {
+    return compare(other) > 0;
+}
+
+bool SignMagnitudeBinary::operator<=(const SignMagnitudeBinary& other) const {
+    return compare(other) <= 0;
+}
+
+bool SignMagnitudeBinary::operator>=(const SignMagnitudeBinary& other) const {
+    return compare(other) >= 0;
+}
+
+/**
+ * \brief Prints the signed value in binary.
+ */
+std::ostream& operator<<(std::ostream& stream, const SignMagnitudeBinary& b) {
+    Binary value = b.to_binary(1);
+    value.printmode = Binary::PrintModes::Signed;
+    return stream << value;
+}
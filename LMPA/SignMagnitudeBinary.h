@@ -0,0 +1,128 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_SIGNMAGNITUDEBINARY_H
+#define LMPA_LIBRARY_SIGNMAGNITUDEBINARY_H
+
+#include <iostream> // operator<< stream overload
+#include <type_traits> // integral constructor
+
+#include "Binary.h"
+#include "Natural.h"
+
+/**
+ * \brief An integer stored as sign and magnitude instead of Binary's two's complement. Negation and absolute value
+ * only touch the sign, in place or on temporaries, and a difference is an addition or subtraction of magnitudes
+ * without negating the subtrahend. The two's complement view is only produced for the bitwise operators.
+ * Values grow as needed and never wrap, like dynamic Binaries. Zero is never negative.
+ */
+class SignMagnitudeBinary {
+public:
+    typedef natural::limb_type                      limb_type;
+    typedef natural::size_type                      size_type;
+    typedef natural::container_type                 container_type;
+
+    template<typename T>
+    using if_integral = typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type;
+
+    /// Constructors ///
+    SignMagnitudeBinary() = default;
+    explicit SignMagnitudeBinary(const Binary& b);
+    SignMagnitudeBinary(container_type magnitude, bool is_negative);
+
+    template<typename T, if_integral<T> = 0>
+    explicit SignMagnitudeBinary(T x) : negative(below_zero(x, std::is_signed<T>())) {
+        const auto value = static_cast<unsigned long long>(x);
+        mag = natural::from_limb(negative ? 0 - value : value);
+    }
+
+    SignMagnitudeBinary(const SignMagnitudeBinary& other) = default;
+    SignMagnitudeBinary(SignMagnitudeBinary&& other) = default;
+
+    ~SignMagnitudeBinary() = default;
+
+    /// Utility ///
+    inline bool sign() const { return negative; }
+    inline bool is_zero() const { return mag.empty(); }
+    inline const container_type& magnitude() const { return mag; }
+    // the smallest two's complement precision holding the value
+    size_type precision() const;
+    // the value as a Binary one bit wider than the magnitude, but at least min_prec
+    Binary to_binary(size_type min_prec = 32) const;
+
+    // both in place, without touching the magnitude
+    inline SignMagnitudeBinary& negate() { negative = !negative && !mag.empty(); return *this; }
+    inline SignMagnitudeBinary& abs() { negative = false; return *this; }
+
+    SignMagnitudeBinary absVal() const & { return SignMagnitudeBinary(*this).abs(); }
+    SignMagnitudeBinary absVal() && { return std::move(abs()); }
+
+    /// Assignment ///
+    SignMagnitudeBinary& operator=(const SignMagnitudeBinary& other) = default;
+    SignMagnitudeBinary& operator=(SignMagnitudeBinary&& other) = default;
+    SignMagnitudeBinary& operator+=(const SignMagnitudeBinary& other);
+    SignMagnitudeBinary& operator-=(const SignMagnitudeBinary& other);
+    SignMagnitudeBinary& operator*=(const SignMagnitudeBinary& other);
+    // truncating division, the remainder has the sign of the dividend. Throw div_by_zero_error for 0
+    SignMagnitudeBinary& operator/=(const SignMagnitudeBinary& other) noexcept(false);
+    SignMagnitudeBinary& operator%=(const SignMagnitudeBinary& other) noexcept(false);
+    SignMagnitudeBinary& operator<<=(size_type n);
+    // arithmetic shift, rounding toward negative infinity like Binary
+    SignMagnitudeBinary& operator>>=(size_type n);
+    // bitwise on the two's complement view
+    SignMagnitudeBinary& operator&=(const SignMagnitudeBinary& other);
+    SignMagnitudeBinary& operator|=(const SignMagnitudeBinary& other);
+    SignMagnitudeBinary& operator^=(const SignMagnitudeBinary& other);
+
+    /// Arithmetic Operators ///
+    SignMagnitudeBinary operator+() const { return *this; }
+    SignMagnitudeBinary operator-() const & { return SignMagnitudeBinary(*this).negate(); }
+    SignMagnitudeBinary operator-() && { return std::move(negate()); }
+    SignMagnitudeBinary operator+(const SignMagnitudeBinary& other) const { return SignMagnitudeBinary(*this) += other; }
+    SignMagnitudeBinary operator-(const SignMagnitudeBinary& other) const { return SignMagnitudeBinary(*this) -= other; }
+    SignMagnitudeBinary operator*(const SignMagnitudeBinary& other) const;
+    SignMagnitudeBinary operator/(const SignMagnitudeBinary& other) const noexcept(false);
+    SignMagnitudeBinary operator%(const SignMagnitudeBinary& other) const noexcept(false);
+    SignMagnitudeBinary operator<<(size_type n) const { return SignMagnitudeBinary(*this) <<= n; }
+    SignMagnitudeBinary operator>>(size_type n) const { return SignMagnitudeBinary(*this) >>= n; }
+
+    /// Bitwise Operators ///
+    SignMagnitudeBinary operator&(const SignMagnitudeBinary& other) const { return SignMagnitudeBinary(*this) &= other; }
+    SignMagnitudeBinary operator|(const SignMagnitudeBinary& other) const { return SignMagnitudeBinary(*this) |= other; }
+    SignMagnitudeBinary operator^(const SignMagnitudeBinary& other) const { return SignMagnitudeBinary(*this) ^= other; }
+    // ~x = -x - 1
+    SignMagnitudeBinary operator~() const;
+
+    /// Comparison Operators ///
+    bool operator==(const SignMagnitudeBinary& other) const;
+    bool operator!=(const SignMagnitudeBinary& other) const;
+    bool operator<(const SignMagnitudeBinary& other) const;
+    bool operator>(const SignMagnitudeBinary& other) const;
+    bool operator<=(const SignMagnitudeBinary& other) const;
+    bool operator>=(const SignMagnitudeBinary& other) const;
+
+    friend std::ostream& operator<<(std::ostream& stream, const SignMagnitudeBinary& b);
+
+private:
+    container_type mag;
+    bool negative = false;
+
+    // adds the magnitude m with the sign negative_m
+    void add_signed(const container_type& m, bool negative_m);
+    // n limbs of the two's complement view
+    container_type twos_complement(size_type n) const;
+    void assign_twos_complement(container_type limbs);
+    template<typename Operation>
+    SignMagnitudeBinary& bitwise(const SignMagnitudeBinary& other, Operation operation);
+    int compare(const SignMagnitudeBinary& other) const;
+
+    template<typename T>
+    static bool below_zero(T x, std::true_type) { return x < 0; }
+    template<typename T>
+    static bool below_zero(T, std::false_type) { return false; }
+
+};
+
+
+#endif //LMPA_LIBRARY_SIGNMAGNITUDEBINARY_H
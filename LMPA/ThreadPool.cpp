@@ -0,0 +1,201 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "ThreadPool.h"
+
+#include <algorithm> // max
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    // the pool and queue the current thread works on, if it is a worker
+    thread_local const ThreadPool* current_pool = nullptr;
+    thread_local ThreadPool::size_type current_queue = 0;
+}
+
+
+/// Constructors ///
+
+/**
+ * \brief Constructor that starts the given number of workers, or one per hardware thread.
+ */
+ThreadPool::ThreadPool(size_type threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (size_type i = 0; i <= threads; ++i) {
+        queues.emplace_back(new Queue);
+    }
+
+    workers.reserve(threads);
+    for (size_type i = 0; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+/**
+ * \brief Destructor. Finishes all submitted tasks before joining the workers.
+ */
+ThreadPool::~ThreadPool() {
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    sleep_cv.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+
+/// Utility ///
+
+/**
+ * \brief Schedules the function for execution and returns a handle to wait for it.
+ */
+ThreadPool::handle_type ThreadPool::submit(task_type function) {
+    handle_type task = std::make_shared<Task>();
+    task->function = std::move(function);
+
+    // counted before it is visible, so that pending never drops below the number of queued tasks
+    ++pending;
+    Queue& queue = *queues[own_queue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back(task);
+    }
+
+    // taking the lock ensures a worker that just found nothing to do is already waiting
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    sleep_cv.notify_one();
+
+    return task;
+}
+
+/**
+ * \brief Blocks until the task has finished, running other tasks in the meantime.
+ */
+void ThreadPool::wait(const handle_type& task) noexcept(false) {
+    const size_type index = own_queue();
+    while (!task->done) {
+        if (!run_one(index)) {
+            std::this_thread::yield();
+        }
+    }
+    if (task->error) {
+        std::rethrow_exception(task->error);
+    }
+}
+
+/**
+ * \brief Returns the queue of the calling worker, or the shared queue for threads outside the pool.
+ */
+ThreadPool::size_type ThreadPool::own_queue() const {
+    return current_pool == this ? current_queue : workers.size();
+}
+
+/**
+ * \brief Takes the newest task from the given queue, or steals the oldest task from another one.
+ */
+ThreadPool::handle_type ThreadPool::take(size_type index) {
+    {
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            handle_type task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return task;
+        }
+    }
+
+    for (size_type i = 1; i < queues.size(); ++i) {
+        Queue& queue = *queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            handle_type task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * \brief Runs a single task if there is one. Returns whether a task was run.
+ */
+bool ThreadPool::run_one(size_type index) {
+    handle_type task = take(index);
+    if (!task) { return false; }
+
+    --pending;
+    try {
+        task->function();
+    } catch (...) {
+        task->error = std::current_exception();
+    }
+    task->done = true;
+    return true;
+}
+
+/**
+ * \brief Worker loop. Sleeps while there is nothing to do.
+ */
+void ThreadPool::work(size_type index) {
+    current_pool = this;
+    current_queue = index;
+
+    while (true) {
+        if (run_one(index)) { continue; }
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        if (stopping && pending == 0) { break; }
+        sleep_cv.wait(lock, [this] { return stopping || pending > 0; });
+    }
+}
+
+
+/// Task Group ///
+
+/**
+ * \brief Destructor. Waits for the tasks not waited for yet, their exceptions are dropped.
+ */
+ThreadPool::TaskGroup::~TaskGroup() {
+    for (const handle_type& task : tasks) {
+        try {
+            pool.wait(task);
+        } catch (...) {}
+    }
+}
+
+/**
+ * \brief Submits the function to the pool. The handle's place is made first, so that a task is never left untracked.
+ */
+void ThreadPool::TaskGroup::submit(task_type function) {
+    tasks.emplace_back();
+    try {
+        tasks.back() = pool.submit(std::move(function));
+    } catch (...) {
+        tasks.pop_back();
+        throw;
+    }
+}
+
+void ThreadPool::TaskGroup::wait() noexcept(false) {
+    std::exception_ptr error;
+    for (const handle_type& task : tasks) {
+        try {
+            pool.wait(task);
+        } catch (...) {
+            if (!error) { error = std::current_exception(); }
+        }
+    }
+    tasks.clear();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
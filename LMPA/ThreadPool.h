@@ -0,0 +1,101 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_THREADPOOL_H
+#define LMPA_LIBRARY_THREADPOOL_H
+
+#include <vector> // container, size_t
+#include <deque> // task queues
+#include <memory> // shared_ptr, unique_ptr
+#include <functional> // function
+#include <thread> // thread
+#include <mutex> // mutex
+#include <condition_variable> // sleeping workers
+#include <atomic> // atomic
+#include <exception> // exception_ptr
+
+/**
+ * \brief Work-stealing thread pool. Every worker owns a queue it takes its newest tasks from,
+ * idle workers steal the oldest tasks of the others. Threads waiting for a task run other tasks in the meantime,
+ * so tasks may safely submit and wait for subtasks.
+ */
+class ThreadPool {
+public:
+    typedef std::size_t                             size_type;
+    typedef std::function<void()>                   task_type;
+
+    class Task {
+        friend class ThreadPool;
+    private:
+        task_type function;
+        std::atomic<bool> done{false};
+        std::exception_ptr error;
+    };
+
+    typedef std::shared_ptr<Task>                   handle_type;
+
+    /**
+     * \brief Tasks submitted to a pool and waited for together. Tasks not waited for are waited for on destruction,
+     * so that tasks referring to the locals of a scope left by an exception finish before the locals are destroyed.
+     */
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& p) : pool(p) {}
+
+        TaskGroup(const TaskGroup& g) = delete;
+        TaskGroup& operator=(const TaskGroup& g) = delete;
+
+        ~TaskGroup();
+
+        inline void reserve(size_type n) { tasks.reserve(n); }
+        void submit(task_type function);
+        // waits for all tasks, then rethrows the first exception thrown by any of them
+        void wait() noexcept(false);
+
+    private:
+        ThreadPool& pool;
+        std::vector<handle_type> tasks;
+    };
+
+
+    /// Constructors ///
+    // 0 threads uses one thread per hardware thread
+    explicit ThreadPool(size_type threads = 0);
+
+    ThreadPool(const ThreadPool& p) = delete;
+    ThreadPool& operator=(const ThreadPool& p) = delete;
+
+    ~ThreadPool();
+
+
+    /// Utility ///
+    inline size_type size() const { return workers.size(); }
+    handle_type submit(task_type function);
+    // rethrows any exception thrown by the task
+    void wait(const handle_type& task) noexcept(false);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<handle_type> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    // one queue per worker, the last one takes tasks submitted from outside the pool
+    std::vector<std::unique_ptr<Queue>> queues;
+
+    std::atomic<bool> stopping{false};
+    std::atomic<size_type> pending{0};
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+
+    size_type own_queue() const;
+    handle_type take(size_type index);
+    bool run_one(size_type index);
+    void work(size_type index);
+
+};
+
+
+#endif //LMPA_LIBRARY_THREADPOOL_H
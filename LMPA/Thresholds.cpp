@@ -0,0 +1,106 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Thresholds.h"
+
+#include <fstream> // table files
+#include <sstream> // line parsing
+#include <cstdlib> // getenv
+#include <algorithm> // max
+
+using thresholds::Table;
+using thresholds::size_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+
+    Table clamped(Table table) {
+        table.karatsuba_mul = std::max(table.karatsuba_mul, thresholds::min_karatsuba);
+        table.karatsuba_sqr = std::max(table.karatsuba_sqr, thresholds::min_karatsuba);
+        return table;
+    }
+
+    // the compiled-in defaults, replaced by the file named by LMPA_THRESHOLDS if it can be loaded
+    Table startup() {
+        Table table;
+        if (const char* path = std::getenv("LMPA_THRESHOLDS")) {
+            thresholds::load(path, table);
+        }
+        return clamped(table);
+    }
+
+    Table& current() {
+        static Table table = startup();
+        return table;
+    }
+
+    size_type* entry(Table& table, const std::string& name) {
+        if (name == "karatsuba_mul") { return &table.karatsuba_mul; }
+        if (name == "karatsuba_sqr") { return &table.karatsuba_sqr; }
+        if (name == "parallel_mul") { return &table.parallel_mul; }
+        if (name == "parallel_product") { return &table.parallel_product; }
+        return nullptr;
+    }
+}
+
+
+/// Utility ///
+
+const Table& thresholds::get() {
+    return current();
+}
+
+void thresholds::set(const Table& table) {
+    current() = clamped(table);
+}
+
+
+/// Table Files ///
+
+/**
+ * \brief Reads a table written by write. Entries missing from the file keep their value in the table.
+ */
+bool thresholds::load(const std::string& path, Table& table) {
+    std::ifstream file(path);
+    if (!file) { return false; }
+
+    Table result = table;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string name, rest;
+        if (!(fields >> name)) { continue; }
+
+        size_type* value = entry(result, name);
+        if (!value || !(fields >> *value) || fields >> rest) { return false; }
+    }
+    table = result;
+    return true;
+}
+
+bool thresholds::load(const std::string& path) {
+    Table table = get();
+    if (!load(path, table)) { return false; }
+    set(table);
+    return true;
+}
+
+void thresholds::write(std::ostream& stream, const Table& table) {
+    stream << "# LMPA thresholds in limbs\n"
+           << "karatsuba_mul " << table.karatsuba_mul << "\n"
+           << "karatsuba_sqr " << table.karatsuba_sqr << "\n"
+           << "parallel_mul " << table.parallel_mul << "\n"
+           << "parallel_product " << table.parallel_product << "\n";
+}
+
+void thresholds::write_header(std::ostream& stream, const Table& table) {
+    stream << "// LMPA thresholds in limbs, generated by calibrate\n"
+           << "#define LMPA_KARATSUBA_MUL_THRESHOLD " << table.karatsuba_mul << "ull\n"
+           << "#define LMPA_KARATSUBA_SQR_THRESHOLD " << table.karatsuba_sqr << "ull\n"
+           << "#define LMPA_PARALLEL_MUL_THRESHOLD " << table.parallel_mul << "ull\n"
+           << "#define LMPA_PARALLEL_PRODUCT_THRESHOLD " << table.parallel_product << "ull\n";
+}
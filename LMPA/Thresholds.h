@@ -0,0 +1,72 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_THRESHOLDS_H
+#define LMPA_LIBRARY_THRESHOLDS_H
+
+#include <string>
+#include <iostream> // table output
+
+#include "Kernels.h"
+
+// a header written by calibrate --header, compiled in with the CMake cache variable of the same name
+#ifdef LMPA_THRESHOLDS_HEADER
+#include LMPA_THRESHOLDS_HEADER
+#endif // LMPA_THRESHOLDS_HEADER
+
+#ifndef LMPA_KARATSUBA_MUL_THRESHOLD
+#define LMPA_KARATSUBA_MUL_THRESHOLD 32
+#endif
+#ifndef LMPA_KARATSUBA_SQR_THRESHOLD
+#define LMPA_KARATSUBA_SQR_THRESHOLD 48
+#endif
+#ifndef LMPA_PARALLEL_MUL_THRESHOLD
+#define LMPA_PARALLEL_MUL_THRESHOLD 1024
+#endif
+#ifndef LMPA_PARALLEL_PRODUCT_THRESHOLD
+#define LMPA_PARALLEL_PRODUCT_THRESHOLD 512
+#endif
+
+/**
+ * \brief The operand sizes in limbs at which the algorithms switch tiers. The defaults are compiled in,
+ * and at the first use a table file named by the environment variable LMPA_THRESHOLDS replaces them,
+ * so that every machine can use the crossovers measured on it by the calibrate tool.
+ */
+namespace thresholds {
+
+    typedef kernels::size_type                      size_type;
+
+    // the smallest Karatsuba threshold, below it the half-size products would not be smaller
+    constexpr size_type min_karatsuba = 4;
+
+    struct Table {
+        // operand limbs from which Karatsuba beats the basecase
+        size_type karatsuba_mul = LMPA_KARATSUBA_MUL_THRESHOLD;
+        // the same for squaring, where the basecase is cheaper
+        size_type karatsuba_sqr = LMPA_KARATSUBA_SQR_THRESHOLD;
+        // operand limbs from which the Karatsuba subproducts are handed to a thread pool
+        size_type parallel_mul = LMPA_PARALLEL_MUL_THRESHOLD;
+        // limbs in a product tree from which its halves are multiplied on a thread pool
+        size_type parallel_product = LMPA_PARALLEL_PRODUCT_THRESHOLD;
+    };
+
+    /// Utility ///
+    // the table in use
+    const Table& get();
+    // replaces the table in use, not while other threads multiply. Karatsuba thresholds are raised to min_karatsuba
+    void set(const Table& table);
+
+    /// Table Files ///
+    // "name value" lines, # starts a comment. Returns false and leaves the table unchanged if the file
+    // cannot be read or has an unknown name or a malformed value
+    bool load(const std::string& path, Table& table);
+    bool load(const std::string& path);
+    void write(std::ostream& stream, const Table& table);
+    // the same values as #defines, for LMPA_THRESHOLDS_HEADER
+    void write_header(std::ostream& stream, const Table& table);
+
+}
+
+
+#endif //LMPA_LIBRARY_THRESHOLDS_H
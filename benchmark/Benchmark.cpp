@@ -0,0 +1,190 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Benchmark.h"
+
+#include <algorithm> // sort, find
+#include <chrono> // timing
+#include <random> // operands
+#include <sstream> // printing
+#include <iomanip> // log formatting
+
+typedef Benchmark::size_type size_type;
+typedef std::chrono::steady_clock clock_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    // results are folded into this, so that the compiler cannot drop the measured calls
+    volatile bool sink = false;
+
+    double elapsed_ns(const clock_type::time_point& start) {
+        return std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+    }
+
+    /**
+     * \brief Random operands of the given precision: a of full width and either sign,
+     * b positive with half the significant bits, so that it also serves as a divisor.
+     */
+    void operands(size_type bits, std::mt19937_64& engine, Binary& a, Binary& b) {
+        Binary::limb_container limbs((bits + kernels::limb_bits - 1) / kernels::limb_bits);
+        for (auto& limb : limbs) { limb = engine(); }
+        a.assign_limbs(limbs, bits);
+
+        const size_type half = std::max<size_type>(bits / 2, 1);
+        for (size_type i = 0; i < limbs.size(); ++i) {
+            const size_type low = i * kernels::limb_bits;
+            limbs[i] = low >= half ? 0 : engine();
+            if (half - low < kernels::limb_bits) {
+                limbs[i] &= (kernels::limb_type(1) << (half - low)) - 1;
+            }
+        }
+        limbs[(half - 1) / kernels::limb_bits] |= kernels::limb_type(1) << ((half - 1) % kernels::limb_bits);
+        b.assign_limbs(limbs, bits);
+    }
+
+    void write_number(std::ostream& stream, double x) {
+        std::ostringstream s;
+        s << std::setprecision(6) << x;
+        stream << s.str();
+    }
+}
+
+
+/// Constructors ///
+
+/**
+ * \brief Registers all operations. Comparisons compare a value with itself, the worst case reading every digit.
+ */
+Benchmark::Benchmark(const Options& o) : options(o) {
+    const std::vector<Operation> all = {
+            {"construct", [](const Binary& a, const Binary&) { return Binary(a.precision()).sign(); }},
+            {"copy", [](const Binary& a, const Binary&) { return Binary(a).sign(); }},
+            {"add", [](const Binary& a, const Binary& b) { return (a + b).sign(); }},
+            {"subtract", [](const Binary& a, const Binary& b) { return (a - b).sign(); }},
+            {"multiply", [](const Binary& a, const Binary& b) { return (a * b).sign(); }},
+            {"divide", [](const Binary& a, const Binary& b) { return (a / b).sign(); }},
+            {"modulo", [](const Binary& a, const Binary& b) { return (a % b).sign(); }},
+            {"shift_left", [](const Binary& a, const Binary&) { return (a << a.precision() / 3).sign(); }},
+            {"shift_right", [](const Binary& a, const Binary&) { return (a >> a.precision() / 3).sign(); }},
+            {"compare", [](const Binary& a, const Binary&) { return a < a; }},
+            {"equal", [](const Binary& a, const Binary&) { return a == a; }},
+            {"negate", [](const Binary& a, const Binary&) { return (-a).sign(); }},
+            {"print", [](const Binary& a, const Binary&) {
+                std::ostringstream stream;
+                stream << a;
+                return stream.tellp() > 0;
+            }},
+    };
+
+    for (const Operation& operation : all) {
+        if (options.operations.empty() || std::find(std::begin(options.operations), std::end(options.operations),
+                                                    operation.name) != std::end(options.operations)) {
+            operations.emplace_back(operation);
+        }
+    }
+}
+
+
+/// Utility ///
+
+/**
+ * \brief Measures every operation at every size. An operation whose single call exceeded max_call_ms
+ * is recorded as skipped at all larger sizes.
+ */
+void Benchmark::run(std::ostream& log) {
+    _results.clear();
+    std::vector<bool> exhausted(operations.size(), false);
+
+    for (size_type bits = options.min_bits; bits <= options.max_bits; bits *= std::max<size_type>(options.step, 2)) {
+        for (size_type i = 0; i < operations.size(); ++i) {
+            if (exhausted[i]) {
+                _results.push_back({operations[i].name, bits, true, 0, 0, 0, 0});
+                continue;
+            }
+
+            double call_ms = 0;
+            _results.push_back(measure(operations[i], bits, call_ms));
+            exhausted[i] = call_ms > options.max_call_ms;
+
+            const Result& r = _results.back();
+            log << std::left << std::setw(12) << r.operation << std::right << std::setw(10) << r.bits << " bits "
+                << std::setw(14) << std::fixed << std::setprecision(1) << r.ns_per_op << " ns/op "
+                << std::setw(12) << std::scientific << std::setprecision(3) << r.bits_per_second << " bits/s"
+                << std::defaultfloat << std::endl;
+        }
+        if (bits > options.max_bits / std::max<size_type>(options.step, 2)) { break; }
+    }
+}
+
+/**
+ * \brief Warms up with untimed calls, which also estimate the batch size reaching min_time_ms,
+ * then times the batches and reports the median and the fastest.
+ */
+Benchmark::Result Benchmark::measure(const Operation& operation, size_type bits, double& call_ms) const {
+    // the same operands for every operation of a size
+    std::mt19937_64 engine(bits);
+    Binary a, b;
+    operands(bits, engine, a, b);
+
+    const unsigned warmup = std::max(options.warmup, 1u);
+    clock_type::time_point start = clock_type::now();
+    for (unsigned i = 0; i < warmup; ++i) {
+        sink = sink != operation.function(a, b);
+    }
+    call_ms = elapsed_ns(start) / warmup / 1e6;
+
+    const auto iterations = static_cast<std::size_t>(std::max(1.0, options.min_time_ms / std::max(call_ms, 1e-6)));
+    std::vector<double> batches;
+    for (unsigned r = 0; r < std::max(options.repetitions, 1u); ++r) {
+        start = clock_type::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            sink = sink != operation.function(a, b);
+        }
+        batches.push_back(elapsed_ns(start) / static_cast<double>(iterations));
+    }
+    std::sort(std::begin(batches), std::end(batches));
+
+    Result result{operation.name, bits, false, iterations, batches[batches.size() / 2], batches.front(), 0};
+    result.bits_per_second = static_cast<double>(bits) * 1e9 / result.ns_per_op;
+    return result;
+}
+
+void Benchmark::write_json(std::ostream& stream) const {
+    stream << "{\n";
+    stream << "  \"library\": \"LMPA\",\n";
+#ifdef __VERSION__
+    stream << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif // compiler version
+#ifdef NDEBUG
+    stream << "  \"assertions\": false,\n";
+#else
+    stream << "  \"assertions\": true,\n";
+#endif // NDEBUG
+    stream << "  \"warmup\": " << options.warmup << ",\n";
+    stream << "  \"repetitions\": " << options.repetitions << ",\n";
+    stream << "  \"min_time_ms\": ";
+    write_number(stream, options.min_time_ms);
+    stream << ",\n  \"max_call_ms\": ";
+    write_number(stream, options.max_call_ms);
+    stream << ",\n  \"results\": [";
+
+    for (std::size_t i = 0; i < _results.size(); ++i) {
+        const Result& r = _results[i];
+        stream << (i ? ",\n" : "\n") << "    {\"operation\": \"" << r.operation << "\", \"bits\": " << r.bits;
+        if (r.skipped) {
+            stream << ", \"skipped\": true}";
+            continue;
+        }
+        stream << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": ";
+        write_number(stream, r.ns_per_op);
+        stream << ", \"min_ns_per_op\": ";
+        write_number(stream, r.min_ns_per_op);
+        stream << ", \"bits_per_second\": ";
+        write_number(stream, r.bits_per_second);
+        stream << "}";
+    }
+    stream << "\n  ]\n}\n";
+}
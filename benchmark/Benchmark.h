@@ -0,0 +1,76 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#ifndef LMPA_LIBRARY_BENCHMARK_H
+#define LMPA_LIBRARY_BENCHMARK_H
+
+#include <string>
+#include <vector> // container
+#include <functional> // operations
+#include <iostream> // log, json output
+
+#include "../LMPA/Binary.h"
+
+/**
+ * \brief Sweeps the operand size of every Binary operation over powers of two and measures ns/op.
+ * Every measurement is calibrated to a minimum batch time, warmed up and repeated, the median batch is reported.
+ */
+class Benchmark {
+public:
+    typedef Binary::size_type                       size_type;
+
+    struct Options {
+        size_type min_bits = 64;
+        size_type max_bits = size_type(1) << 24;
+        // factor between successive sizes
+        size_type step = 2;
+        // untimed calls before the measurement
+        unsigned warmup = 2;
+        // timed batches, each of at least min_time_ms
+        unsigned repetitions = 5;
+        double min_time_ms = 20;
+        // an operation is not measured at larger sizes once a single call took longer than this
+        double max_call_ms = 2000;
+        // names of the operations to run, all if empty
+        std::vector<std::string> operations;
+    };
+
+    struct Result {
+        std::string operation;
+        size_type bits;
+        bool skipped;
+        std::size_t iterations; // per batch
+        double ns_per_op; // median over the batches
+        double min_ns_per_op;
+        double bits_per_second;
+    };
+
+    // an operation on two random operands of the same precision, returns a value depending on the result
+    typedef std::function<bool(const Binary& a, const Binary& b)> operation_type;
+
+    /// Constructors ///
+    explicit Benchmark(const Options& o);
+
+    /// Utility ///
+    // runs the sweep, with progress written to the log
+    void run(std::ostream& log);
+    inline const std::vector<Result>& results() const { return _results; }
+    void write_json(std::ostream& stream) const;
+
+private:
+    struct Operation {
+        std::string name;
+        operation_type function;
+    };
+
+    Options options;
+    std::vector<Operation> operations;
+    std::vector<Result> _results;
+
+    Result measure(const Operation& operation, size_type bits, double& call_ms) const;
+
+};
+
+
+#endif //LMPA_LIBRARY_BENCHMARK_H
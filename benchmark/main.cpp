@@ -0,0 +1,74 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "Benchmark.h"
+
+#include <fstream> // json output
+#include <cstring> // strcmp
+#include <cstdlib> // strtoull, strtod
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+
+    void usage(const char* name) {
+        std::cerr << "usage: " << name << " [options]\n"
+                  << "  --min-bits N        smallest operand size in bits (default 64)\n"
+                  << "  --max-bits N        largest operand size in bits (default 16777216)\n"
+                  << "  --step N            factor between sizes (default 2)\n"
+                  << "  --warmup N          untimed calls per measurement (default 2)\n"
+                  << "  --repetitions N     timed batches per measurement (default 5)\n"
+                  << "  --min-time MS       minimum time of a batch (default 20)\n"
+                  << "  --max-call MS       larger sizes are skipped after a slower call (default 2000)\n"
+                  << "  --operation NAME    only run this operation, may be repeated\n"
+                  << "  --output FILE       write the JSON report to FILE instead of stdout\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    Benchmark::Options options;
+    const char* output = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--min-bits") && has_value) {
+            options.min_bits = std::max<Benchmark::size_type>(std::strtoull(argv[++i], nullptr, 10), 2);
+        } else if (!std::strcmp(argv[i], "--max-bits") && has_value) {
+            options.max_bits = std::strtoull(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--step") && has_value) {
+            options.step = std::strtoull(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--warmup") && has_value) {
+            options.warmup = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--repetitions") && has_value) {
+            options.repetitions = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--min-time") && has_value) {
+            options.min_time_ms = std::strtod(argv[++i], nullptr);
+        } else if (!std::strcmp(argv[i], "--max-call") && has_value) {
+            options.max_call_ms = std::strtod(argv[++i], nullptr);
+        } else if (!std::strcmp(argv[i], "--operation") && has_value) {
+            options.operations.emplace_back(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--output") && has_value) {
+            output = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Benchmark benchmark(options);
+    benchmark.run(std::cerr);
+
+    if (output) {
+        std::ofstream file(output);
+        if (!file) {
+            std::cerr << "cannot write " << output << std::endl;
+            return 1;
+        }
+        benchmark.write_json(file);
+    } else {
+        benchmark.write_json(std::cout);
+    }
+    return 0;
+}
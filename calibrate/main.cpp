@@ -0,0 +1,192 @@
+//
+// Created by Lars on 19/10/2026.
+//
+
+#include "../LMPA/Thresholds.h"
+#include "../LMPA/ThreadPool.h"
+
+#include <chrono> // timing
+#include <random> // operands
+#include <vector> // operands
+#include <limits> // never
+#include <fstream> // output files
+#include <cstring> // strcmp
+#include <cstdlib> // strtod, strtoull
+#include <algorithm> // sort, max
+
+using thresholds::size_type;
+using kernels::limb_type;
+typedef std::chrono::steady_clock clock_type;
+
+/**
+ * \brief Locally used functions and variables.
+ */
+namespace {
+    // a threshold that is never reached
+    constexpr size_type never = std::numeric_limits<size_type>::max();
+    // consecutive sizes at which the upper tier has to win for a crossover
+    constexpr int confirmations = 3;
+
+    struct Options {
+        double min_time_ms = 10;
+        unsigned repetitions = 3;
+        size_type max_karatsuba = 512;
+        size_type max_parallel = 16384;
+        ThreadPool::size_type threads = 0;
+    };
+
+    /**
+     * \brief Median ns per call over the repetitions, each a batch of at least min_time_ms.
+     */
+    template<typename Function>
+    double time_ns(Function function, const Options& options) {
+        clock_type::time_point start = clock_type::now();
+        function();
+        const double call = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+        const auto iterations = static_cast<std::size_t>(std::max(1.0, options.min_time_ms * 1e6 / std::max(call, 1.0)));
+
+        std::vector<double> batches;
+        for (unsigned r = 0; r < std::max(options.repetitions, 1u); ++r) {
+            start = clock_type::now();
+            for (std::size_t i = 0; i < iterations; ++i) {
+                function();
+            }
+            batches.push_back(std::chrono::duration<double, std::nano>(clock_type::now() - start).count() / iterations);
+        }
+        std::sort(std::begin(batches), std::end(batches));
+        return batches[batches.size() / 2];
+    }
+
+    /**
+     * \brief Times a multiplication or squaring of n limbs with the threshold field of the table set to never
+     * and to n, so that only the top level uses the upper tier. Returns the first of confirmations consecutive
+     * sizes at which the upper tier wins, or never.
+     */
+    size_type crossover(const char* name, size_type thresholds::Table::* field, const std::vector<size_type>& sizes,
+                        bool square, ThreadPool* pool, const Options& options) {
+        std::mt19937_64 engine(7);
+        const thresholds::Table original = thresholds::get();
+        size_type candidate = never;
+        int wins = 0;
+
+        for (const size_type n : sizes) {
+            std::vector<limb_type> a(n), b(n), r(2 * n);
+            for (auto& limb : a) { limb = engine(); }
+            for (auto& limb : b) { limb = engine(); }
+            const limb_type* second = square ? a.data() : b.data();
+            const auto multiply = [&] { kernels::mul(r.data(), a.data(), n, second, n, pool); };
+
+            thresholds::Table table = original;
+            table.*field = never;
+            thresholds::set(table);
+            const double lower = time_ns(multiply, options);
+            table.*field = n;
+            thresholds::set(table);
+            const double upper = time_ns(multiply, options);
+
+            std::cerr << name << " " << n << " limbs: " << lower << " ns below, " << upper << " ns above" << std::endl;
+            if (upper < lower) {
+                if (wins++ == 0) { candidate = n; }
+                if (wins == confirmations) { break; }
+            } else {
+                wins = 0;
+                candidate = never;
+            }
+        }
+        thresholds::set(original);
+        return wins ? candidate : never;
+    }
+
+    // sizes growing by about 12% from first to last
+    std::vector<size_type> sizes(size_type first, size_type last) {
+        std::vector<size_type> result;
+        for (size_type n = first; n <= last; n = std::max(n + 1, n + n / 8)) {
+            result.push_back(n);
+        }
+        return result;
+    }
+
+    void usage(const char* name) {
+        std::cerr << "usage: " << name << " [options]\n"
+                  << "  --output FILE       write the thresholds table to FILE, load it with LMPA_THRESHOLDS=FILE\n"
+                  << "  --header FILE       write the thresholds as a header, compile it in with\n"
+                  << "                      -DLMPA_THRESHOLDS_HEADER=FILE\n"
+                  << "  --min-time MS       minimum time of a timed batch (default 10)\n"
+                  << "  --repetitions N     timed batches per measurement (default 3)\n"
+                  << "  --max-karatsuba N   largest operand limbs tried for Karatsuba (default 512)\n"
+                  << "  --max-parallel N    largest operand limbs tried for threads (default 16384)\n"
+                  << "  --threads N         threads of the pool, 0 for one per hardware thread (default 0)\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    const char* output = nullptr;
+    const char* header = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--output") && has_value) {
+            output = argv[++i];
+        } else if (!std::strcmp(argv[i], "--header") && has_value) {
+            header = argv[++i];
+        } else if (!std::strcmp(argv[i], "--min-time") && has_value) {
+            options.min_time_ms = std::strtod(argv[++i], nullptr);
+        } else if (!std::strcmp(argv[i], "--repetitions") && has_value) {
+            options.repetitions = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(argv[i], "--max-karatsuba") && has_value) {
+            options.max_karatsuba = std::strtoull(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--max-parallel") && has_value) {
+            options.max_parallel = std::strtoull(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--threads") && has_value) {
+            options.threads = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    thresholds::Table table = thresholds::get();
+    const std::vector<size_type> karatsuba_sizes = sizes(thresholds::min_karatsuba * 2, options.max_karatsuba);
+
+    // squaring first, the Karatsuba squares do not depend on the multiplication threshold
+    size_type found = crossover("karatsuba_sqr", &thresholds::Table::karatsuba_sqr, karatsuba_sizes, true,
+                                nullptr, options);
+    if (found != never) { table.karatsuba_sqr = found; }
+    found = crossover("karatsuba_mul", &thresholds::Table::karatsuba_mul, karatsuba_sizes, false, nullptr, options);
+    if (found != never) { table.karatsuba_mul = found; }
+    thresholds::set(table);
+
+    // without a second thread, handing subproducts to the pool only adds overhead
+    ThreadPool pool(options.threads);
+    table.parallel_mul = never;
+    if (pool.size() > 1) {
+        std::vector<size_type> parallel_sizes;
+        for (size_type n = std::max<size_type>(table.karatsuba_mul * 2, 64); n <= options.max_parallel; n *= 2) {
+            parallel_sizes.push_back(n);
+        }
+        table.parallel_mul = crossover("parallel_mul", &thresholds::Table::parallel_mul, parallel_sizes, false,
+                                       &pool, options);
+    }
+    // a product tree node of that many limbs has halves of about half the size, as in the defaults
+    table.parallel_product = table.parallel_mul == never ? never : table.parallel_mul / 2;
+
+    thresholds::write(std::cout, table);
+    if (output) {
+        std::ofstream file(output);
+        thresholds::write(file, table);
+        if (!file) {
+            std::cerr << "cannot write " << output << std::endl;
+            return 1;
+        }
+    }
+    if (header) {
+        std::ofstream file(header);
+        thresholds::write_header(file, table);
+        if (!file) {
+            std::cerr << "cannot write " << header << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -1,11 +1,25 @@
 #include "Random.h"
+#include "../LMPA/Natural.h"
 
 /// Standard Libraries ///
 #include <chrono>
+#include <atomic> // thread counter
+#include <stdexcept> // domain_error
 
 /// Statics ///
 std::random_device Random::rd;
-std::mt19937_64 Random::eng;
+thread_local std::mt19937_64 Random::eng(Random::threadSeed());
+
+
+/// gives every thread's generator a different default seed, in the order the threads first use it
+std::uint64_t Random::threadSeed() {
+    static std::atomic<std::uint64_t> threads{0};
+    // splitmix64 of the thread number, so that neighbouring seeds give unrelated streams
+    std::uint64_t z = threads.fetch_add(1) * 0x9E3779B97F4A7C15ull + std::mt19937_64::default_seed;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
 
 
 /// generates a random seed for the mersenne twister engine based on the current system time
@@ -20,6 +34,16 @@ void Random::generateSeed() {
     }
 }
 
+/// seeds the calling thread's generator, for reproducible runs
+void Random::seed(std::uint64_t seed) {
+    eng.seed(seed);
+}
+
+/// the calling thread's generator
+std::mt19937_64& Random::engine() {
+    return eng;
+}
+
 /// returns true the specified percentage of the time
 bool Random::get(double chance) {
     std::uniform_real_distribution<double> dist(0, 1);
@@ -58,4 +82,44 @@ int Random::pm() {
         return 1;
     }
     return -1;
-}
\ No newline at end of file
+}
+
+/// returns a Binary of the given precision with all bits random, one generator call per 64 bits
+Binary Random::getBinary(Binary::size_type bits) noexcept(false) {
+    if (bits == 0) {
+        // a Binary needs at least its sign bit
+        throw std::domain_error("Random Binary of precision 0.");
+    }
+    Binary::limb_container limbs(kernels::limbs_for(bits));
+    for (auto& limb : limbs) {
+        limb = eng();
+    }
+    Binary result;
+    result.assign_limbs(limbs, bits);
+    return result;
+}
+
+/// returns a random value in [0, bound) of the bound's precision, by rejecting values of the bound's bit length above it
+Binary Random::getBelow(const Binary& bound) noexcept(false) {
+    const Binary::limb_container range = bound.magnitude();
+    if (range.empty() || bound.sign()) {
+        throw std::domain_error("Random value below a nonpositive bound.");
+    }
+    const Binary::size_type bits = natural::bit_length(range);
+    const unsigned top = static_cast<unsigned>(bits % kernels::limb_bits);
+
+    Binary::limb_container limbs(range.size());
+    do {
+        for (auto& limb : limbs) {
+            limb = eng();
+        }
+        if (top) {
+            limbs.back() &= (kernels::limb_type(1) << top) - 1;
+        }
+    } while (natural::compare(limbs, range) >= 0);
+
+    Binary result;
+    result.assign_limbs(limbs, bound.precision());
+    result.storage_type = bound.storage_type;
+    return result;
+}
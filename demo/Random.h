@@ -5,12 +5,18 @@
 #define RANDOM_LIBRARY_H
 
 #include <random>
+#include <cstdint> // uint64_t
+
+#include "../LMPA/Binary.h"
 
 
 class Random {
 private:
     static std::random_device rd;
-    static std::mt19937_64 eng;
+    // one generator per thread, so that parallel workers do not contend on it
+    static thread_local std::mt19937_64 eng;
+
+    static std::uint64_t threadSeed();
 
 public:
     /// non-instantiated class ///
@@ -19,7 +25,10 @@ public:
     Random(const Random& R) = delete;
     Random& operator=(const Random& R) = delete;
 
+    // both seed the calling thread's generator only
     static void generateSeed();
+    static void seed(std::uint64_t seed);
+    static std::mt19937_64& engine();
 
     static bool get();
     static bool get(double chance);
@@ -29,6 +38,11 @@ public:
 
     static int pm();
 
+    // uniformly random Binary of the given precision, filled a limb at a time. Throws std::domain_error for 0
+    static Binary getBinary(Binary::size_type bits) noexcept(false);
+    // uniformly random value in [0, bound), throws std::domain_error if bound is not positive
+    static Binary getBelow(const Binary& bound) noexcept(false);
+
 };
 
 
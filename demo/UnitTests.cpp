@@ -4,8 +4,39 @@
 
 #include "UnitTests.h"
 #include "../LMPA/Binary.h"
+#include "../LMPA/Kernels.h"
+#include "../LMPA/BinaryBatch.h"
+#include "../LMPA/ThreadPool.h"
+#include "../LMPA/Products.h"
+#include "../LMPA/Powers.h"
+#include "../LMPA/Roots.h"
+#include "../LMPA/GCD.h"
+#include "../LMPA/Primes.h"
+#include "../LMPA/Montgomery.h"
+#include "../LMPA/Instrumentation.h"
+#include "../LMPA/Thresholds.h"
+#include "../LMPA/DivisorU64.h"
+#include "../LMPA/ModBinary.h"
+#include "../LMPA/RNS.h"
+#include "../LMPA/SignMagnitudeBinary.h"
+#include "../LMPA/BinaryAccumulator.h"
+#include "Random.h"
+#include "../LMPA/LMPA.h"
+#include "../LMPA/Natural.h"
+#include "../LMPA/FixedPoint.h"
 
 #include <cassert>
+#include <random> // kernel test data
+#include <cmath> // sqrt, nextafter
+#include <cfloat> // DBL_MIN
+#include <sstream> // stream output test
+#include <limits> // extreme values
+#include <thread> // per-thread generators
+#include <stdexcept> // domain_error
+#include <fstream> // threshold files
+#include <cstdio> // remove
+#include <atomic> // concurrent copies
+#include <chrono> // slow tasks
 
 void UnitTests::run() {
     assert(SmallerThan());
@@ -42,6 +73,58 @@ void UnitTests::run() {
     std::cout << "Successfully Passed Test PreDecrement" << std::endl;
     assert(PostDecrement());
     std::cout << "Successfully Passed Test PostDecrement" << std::endl;
+    assert(Kernels());
+    std::cout << "Successfully Passed Test Kernels" << std::endl;
+    assert(Batch());
+    std::cout << "Successfully Passed Test Batch" << std::endl;
+    assert(Karatsuba());
+    std::cout << "Successfully Passed Test Karatsuba" << std::endl;
+    assert(Squaring());
+    std::cout << "Successfully Passed Test Squaring" << std::endl;
+    assert(ParallelMultiply());
+    std::cout << "Successfully Passed Test ParallelMultiply" << std::endl;
+    assert(Products());
+    std::cout << "Successfully Passed Test Products" << std::endl;
+    assert(Powers());
+    std::cout << "Successfully Passed Test Powers" << std::endl;
+    assert(Roots());
+    std::cout << "Successfully Passed Test Roots" << std::endl;
+    assert(GCD());
+    std::cout << "Successfully Passed Test GCD" << std::endl;
+    assert(Primes());
+    std::cout << "Successfully Passed Test Primes" << std::endl;
+    assert(RandomBinary());
+    std::cout << "Successfully Passed Test RandomBinary" << std::endl;
+    assert(Instrumentation());
+    std::cout << "Successfully Passed Test Instrumentation" << std::endl;
+    assert(Thresholds());
+    std::cout << "Successfully Passed Test Thresholds" << std::endl;
+    assert(LongDivision());
+    std::cout << "Successfully Passed Test LongDivision" << std::endl;
+    assert(DynamicStorage());
+    std::cout << "Successfully Passed Test DynamicStorage" << std::endl;
+    assert(CheckedArithmetic());
+    std::cout << "Successfully Passed Test CheckedArithmetic" << std::endl;
+    assert(ScalarArithmetic());
+    std::cout << "Successfully Passed Test ScalarArithmetic" << std::endl;
+    assert(InvariantDivisor());
+    std::cout << "Successfully Passed Test InvariantDivisor" << std::endl;
+    assert(ExactDivision());
+    std::cout << "Successfully Passed Test ExactDivision" << std::endl;
+    assert(ModularArithmetic());
+    std::cout << "Successfully Passed Test ModularArithmetic" << std::endl;
+    assert(ResidueNumberSystem());
+    std::cout << "Successfully Passed Test ResidueNumberSystem" << std::endl;
+    assert(SignMagnitude());
+    std::cout << "Successfully Passed Test SignMagnitude" << std::endl;
+    assert(CopyOnWrite());
+    std::cout << "Successfully Passed Test CopyOnWrite" << std::endl;
+    assert(Summation());
+    std::cout << "Successfully Passed Test Summation" << std::endl;
+    assert(Floating());
+    std::cout << "Successfully Passed Test Floating" << std::endl;
+    assert(FixedPoint());
+    std::cout << "Successfully Passed Test FixedPoint" << std::endl;
 
 
     assert(Other());
@@ -246,6 +329,1067 @@ bool UnitTests::SmallerThan() {
     return a < b && !(b < a);
 }
 
+bool UnitTests::Kernels() {
+    // every supported path has to agree with the generic kernels
+    typedef std::vector<kernels::limb_type> limbs;
+    std::mt19937_64 eng(1234);
+    const kernels::Path original = kernels::active_path();
+
+    for (kernels::size_type n : {1, 3, 4, 7, 16, 33}) {
+        limbs a(n), b(n);
+        for (kernels::size_type i = 0; i < n; ++i) {
+            a[i] = eng();
+            b[i] = eng();
+        }
+        // force long carry chains
+        a[n / 2] = ~kernels::limb_type(0);
+        b[0] = ~kernels::limb_type(0);
+
+        kernels::select_path(kernels::Path::Generic);
+        limbs sum(n), diff(n), prod(n), addprod(a), full(2 * n);
+        kernels::limb_type c1 = kernels::add_n(sum.data(), a.data(), b.data(), n);
+        kernels::limb_type c2 = kernels::sub_n(diff.data(), a.data(), b.data(), n);
+        kernels::limb_type c3 = kernels::mul_1(prod.data(), a.data(), n, b[n - 1]);
+        kernels::limb_type c4 = kernels::addmul_1(addprod.data(), b.data(), n, a[0]);
+        kernels::mul_basecase(full.data(), a.data(), n, b.data(), n);
+
+        for (kernels::Path path : {kernels::Path::AVX2, kernels::Path::ADX_BMI2}) {
+            if (!kernels::select_path(path)) { continue; }
+            limbs sum2(n), diff2(n), prod2(n), addprod2(a), full2(2 * n);
+            if (kernels::add_n(sum2.data(), a.data(), b.data(), n) != c1 || sum2 != sum) { return false; }
+            if (kernels::sub_n(diff2.data(), a.data(), b.data(), n) != c2 || diff2 != diff) { return false; }
+            if (kernels::mul_1(prod2.data(), a.data(), n, b[n - 1]) != c3 || prod2 != prod) { return false; }
+            if (kernels::addmul_1(addprod2.data(), b.data(), n, a[0]) != c4 || addprod2 != addprod) { return false; }
+            kernels::mul_basecase(full2.data(), a.data(), n, b.data(), n);
+            if (full2 != full) { return false; }
+        }
+    }
+    kernels::select_path(original);
+
+    // signed products across limb boundaries
+    Binary a(-55, true);
+    Binary b(6, true);
+    a.reserve(200);
+    return a * b == Binary(-55 * 6, true) && b * a == Binary(-55 * 6, true);
+}
+
+bool UnitTests::Batch() {
+    // every elementwise operation has to agree with the corresponding Binary operator
+    std::mt19937_64 eng(4321);
+    constexpr Binary::size_type prec = 150;
+    constexpr std::size_t count = 21; // not a multiple of the lanes
+
+    std::vector<Binary> a, b;
+    for (std::size_t i = 0; i < count; ++i) {
+        Binary::container_type da(prec), db(prec);
+        for (std::size_t j = 0; j < prec; ++j) {
+            da[j] = eng() & 1;
+            // make the divisors considerably smaller than the dividends
+            db[j] = j > prec / 2 || j == 0 ? eng() & 1 : db[0];
+        }
+        a.emplace_back(da);
+        b.emplace_back(db);
+        if (!b.back()) { ++b.back(); }
+    }
+    // a smaller precision operand has to be sign-extended
+    b[3] = Binary(-7, true);
+
+    BinaryBatch ba(a), bb(b);
+    std::vector<Binary> sum = (ba + bb).values();
+    std::vector<Binary> diff = (ba - bb).values();
+    std::vector<Binary> prod = (ba * bb).values();
+    std::vector<Binary> mod = (ba % bb).values();
+    std::vector<int> cmp = ba.compare(bb);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        Binary bi = b[i];
+        bi.reserve(prec);
+        if (sum[i] != a[i] + bi) { return false; }
+        if (diff[i] != a[i] - bi) { return false; }
+        if (prod[i] != a[i] * bi) { return false; }
+        if (mod[i] != a[i] % bi) { return false; }
+        if (cmp[i] != (a[i] < bi ? -1 : (a[i] == bi ? 0 : 1))) { return false; }
+    }
+    // a batch needs at least the sign bit
+    bool thrown = false;
+    try { BinaryBatch empty(count, 0); } catch (const std::invalid_argument&) { thrown = true; }
+    return thrown && ba.compare(ba) == std::vector<int>(count, 0);
+}
+
+bool UnitTests::Karatsuba() {
+    // Karatsuba has to agree with the basecase, including unbalanced and odd sizes
+    typedef std::vector<kernels::limb_type> limbs;
+    std::mt19937_64 eng(99);
+
+    for (auto sizes : {std::make_pair(32, 32), std::make_pair(77, 77), std::make_pair(200, 65),
+                       std::make_pair(64, 250)}) {
+        const std::size_t an = sizes.first, bn = sizes.second;
+        limbs a(an), b(bn);
+        for (auto& limb : a) { limb = eng(); }
+        for (auto& limb : b) { limb = ~kernels::limb_type(0) - (eng() & 3); }
+
+        limbs expected(an + bn), result(an + bn);
+        kernels::mul_basecase(expected.data(), a.data(), an, b.data(), bn);
+        kernels::mul(result.data(), a.data(), an, b.data(), bn);
+        if (result != expected) { return false; }
+    }
+    return true;
+}
+
+bool UnitTests::Squaring() {
+    // basecase and Karatsuba squaring have to agree with the general multiplication
+    typedef std::vector<kernels::limb_type> limbs;
+    std::mt19937_64 eng(34);
+
+    for (std::size_t n : {1, 2, 3, 47, 48, 100, 301}) {
+        limbs a(n), copy;
+        for (auto& limb : a) { limb = n % 2 ? eng() : ~kernels::limb_type(0); }
+        copy = a;
+
+        limbs expected(2 * n), result(2 * n);
+        kernels::mul_basecase(expected.data(), a.data(), n, copy.data(), n);
+        kernels::sqr(result.data(), a.data(), n);
+        if (result != expected) { return false; }
+        kernels::mul(result.data(), a.data(), n, a.data(), n);
+        if (result != expected) { return false; }
+    }
+
+    // Binary squares wrap like products and grow if dynamic
+    Binary x(-123456789, true), y(x);
+    if (x.sqr() != x * y) { return false; }
+    x.reserve(256);
+    x.storage_type = Binary::StorageType::Dynamic;
+    for (int i = 0; i < 4; ++i) { x *= x; }
+    y = Binary(-123456789, true);
+    y.reserve(1024);
+    for (int i = 0; i < 15; ++i) { y *= Binary(-123456789, true); }
+    return x == y && x.sqr() == x * y;
+}
+
+bool UnitTests::ParallelMultiply() {
+    // the parallel product has to be identical to the serial one
+    std::mt19937_64 eng(7);
+    constexpr Binary::size_type prec = 1 << 18;
+
+    Binary::container_type da(prec), db(prec);
+    for (std::size_t i = 0; i < prec; ++i) {
+        da[i] = eng() & 1;
+        db[i] = i > prec / 3 ? eng() & 1 : 0;
+    }
+    Binary a(da), b(db);
+
+    ThreadPool pool(4);
+    const Binary serial = a * b;
+    if (multiply(a, b, pool) != serial || multiply(b, -a, pool) != -serial) { return false; }
+
+    // a task group rethrows only once all of its tasks have finished, and a scope left by an exception waits for them
+    std::atomic<int> finished(0);
+    const auto slow = [&finished] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ++finished;
+    };
+    try {
+        ThreadPool::TaskGroup group(pool);
+        group.submit([] { throw std::runtime_error("task"); });
+        group.submit(slow);
+        group.wait();
+        return false;
+    } catch (const std::runtime_error&) {
+        if (finished != 1) { return false; }
+    }
+    try {
+        ThreadPool::TaskGroup group(pool);
+        group.submit(slow);
+        throw std::runtime_error("scope");
+    } catch (const std::runtime_error&) {
+        if (finished != 2) { return false; }
+    }
+    return true;
+}
+
+bool UnitTests::Products() {
+    if (factorial(0) != Binary(1, true) || factorial(20) != Binary(2432902008176640000ull, true)) { return false; }
+    if (binomial(10, 3) != Binary(120, true) || binomial(3, 10) != Binary(0, true)) { return false; }
+
+    // compare against folding with operator*=
+    Binary folded(1, true);
+    folded.reserve(1024);
+    std::vector<Binary> factors;
+    for (int i = 1; i <= 150; ++i) {
+        folded *= Binary(i, true);
+        factors.emplace_back(i % 7 ? i : -i, true);
+    }
+    if (factorial(150) != folded) { return false; }
+    // 21 negative factors
+    if (product(std::begin(factors), std::end(factors)) != -folded) { return false; }
+    Binary choose = binomial(150, 70);
+    choose.reserve(1024);
+    if (choose * factorial(70) * factorial(80) != folded) { return false; }
+
+    ThreadPool pool(4);
+    return factorial(5000, pool) == factorial(5000) && binomial(6000, 2500, pool) == binomial(6000, 3500);
+}
+
+bool UnitTests::Powers() {
+    // pow has to agree with repeated multiplication, both wrapping and dynamic
+    std::mt19937_64 eng(35);
+    for (int i = 0; i < 50; ++i) {
+        Binary base(static_cast<std::int64_t>(eng()) >> (eng() % 64), true);
+        const std::uint64_t exponent = eng() % 200;
+        Binary expected(1, true), dynamic(base);
+        expected.reserve(64);
+        dynamic.storage_type = Binary::StorageType::Dynamic;
+        Binary exact(1, true);
+        exact.storage_type = Binary::StorageType::Dynamic;
+        for (std::uint64_t j = 0; j < exponent; ++j) {
+            expected *= base;
+            exact *= base;
+        }
+        if (pow(base, exponent) != expected || pow(dynamic, exponent) != exact) { return false; }
+        if (pow(base, Binary(exponent, true)) != expected) { return false; }
+    }
+
+    // powers of two are shifts, and wrap to 0
+    Binary two(2, true), minus_four(-4, true);
+    two.storage_type = Binary::StorageType::Dynamic;
+    if (pow(two, 1000) != Binary::from_magnitude(natural::shl(natural::from_limb(1), 1000), false)) { return false; }
+    if (pow(minus_four, 15) != Binary(-(1 << 30), true) || pow(minus_four, 16) != Binary(0, true)) { return false; }
+    if (pow(Binary(3, true), 40).precision() != 32 || pow(two, 0) != Binary(1, true)) { return false; }
+
+    // 3^(2^70) modulo 2^32 needs a multi-limb exponent
+    Binary huge(1, true);
+    huge.reserve(128);
+    huge <<= 70;
+    Binary expected(3, true);
+    for (int i = 0; i < 70; ++i) { expected *= expected; }
+    if (pow(Binary(3, true), huge) != expected) { return false; }
+
+    try {
+        pow(two, Binary(-1, true));
+        return false;
+    } catch (const std::domain_error&) {
+        return true;
+    }
+}
+
+bool UnitTests::Roots() {
+    // r^n <= a < (r + 1)^n for random values of many sizes, through all levels of the precision doubling
+    std::mt19937_64 eng(36);
+    for (std::size_t limbs : {1, 2, 3, 5, 17, 80}) {
+        for (std::uint64_t n : {2, 3, 5, 12}) {
+            natural::container_type magnitude(limbs);
+            for (auto& limb : magnitude) { limb = eng(); }
+            const Binary a = Binary::from_magnitude(magnitude, false);
+            Binary r = iroot(a, n), next = r + Binary(1, true);
+            next.storage_type = r.storage_type = Binary::StorageType::Dynamic;
+            if (pow(r, n) > a || !(pow(next, n) > a)) { return false; }
+        }
+    }
+
+    // sqrtrem of squares and their neighbours
+    Binary x = factorial(300), root, remainder;
+    x.storage_type = Binary::StorageType::Dynamic;
+    sqrtrem(x * x, root, remainder);
+    if (root != x || remainder != Binary(0, true)) { return false; }
+    sqrtrem(x * x - Binary(1, true), root, remainder);
+    if (root != x - Binary(1, true) || remainder != x + x - Binary(2, true)) { return false; }
+    if (isqrt(Binary(99, true)) != Binary(9, true) || iroot(Binary(-30, true), 3) != Binary(-3, true)) { return false; }
+
+    // perfect powers
+    Binary three(3, true), six(6, true);
+    three.storage_type = six.storage_type = Binary::StorageType::Dynamic;
+    if (!is_perfect_power(pow(three, 101)) || !is_perfect_power(-pow(six, 35)) || !is_perfect_power(Binary(-1, true))) {
+        return false;
+    }
+    if (is_perfect_power(pow(three, 101) + Binary(1, true)) || is_perfect_power(-pow(six, 32))) { return false; }
+    if (!is_perfect_power(Binary(1 << 12, true)) || is_perfect_power(Binary(-(1 << 8), true))) { return false; }
+
+    // odd operands of more than 100k bits, which no trailing zeros rule out: the powers of a large root are found
+    // through the residue tests, those of a small root through its floating point estimate, and odd neighbours are
+    // rejected by the cheap tests instead of a root and a power for each of the ten thousand prime exponents
+    natural::container_type base(13);
+    for (auto& limb : base) { limb = eng(); }
+    base[0] |= 1;
+    const Binary large_root = Binary::from_magnitude(natural::pow(base, 127), false);
+    const Binary small_root = Binary::from_magnitude(natural::pow(natural::from_limb(3), 65537), true);
+    if (large_root.precision() < 100000 || small_root.precision() < 100000) { return false; }
+    if (!is_perfect_power(large_root) || !is_perfect_power(small_root)) { return false; }
+    if (is_perfect_power(large_root + Binary(2, true)) || is_perfect_power(small_root - Binary(2, true))) { return false; }
+
+    try {
+        isqrt(Binary(-4, true));
+        return false;
+    } catch (const std::domain_error&) {
+        return true;
+    }
+}
+
+bool UnitTests::GCD() {
+    // gcd(a * c, b * c) = c for coprime a and b, here consecutive values, of many sizes and signs
+    std::mt19937_64 eng(37);
+    for (std::size_t limbs : {1, 2, 3, 10, 40}) {
+        for (int i = 0; i < 5; ++i) {
+            natural::container_type ma(limbs), mc(limbs / 2 + 1);
+            for (auto& limb : ma) { limb = eng(); }
+            for (auto& limb : mc) { limb = eng() | 1; }
+            Binary a = Binary::from_magnitude(ma, i % 2 == 1), c = Binary::from_magnitude(mc, false);
+            a.storage_type = c.storage_type = Binary::StorageType::Dynamic;
+            Binary b = a + Binary(i % 2 ? -1 : 1, true);
+            if (i == 4) { b = b * pow(c, 3); }
+            const Binary x = a * c, y = b * c;
+
+            if (gcd(x, y) != c || gcd(y, x) != c || lcm(x, y) != (a * b * c).absVal()) { return false; }
+            Binary g, s, t;
+            gcdext(x, y, g, s, t);
+            Binary combination = s * x + t * y;
+            if (g != c || combination != c) { return false; }
+
+            // a is invertible modulo b
+            Binary inverse;
+            Binary modulus = b.absVal();
+            if (!invert(inverse, a, modulus) || inverse.sign() || !(inverse < modulus)) { return false; }
+            if ((a * inverse - Binary(1, true)) % modulus != Binary(0, true)) { return false; }
+            if (modulus != Binary(1, true) && invert(inverse, x * modulus, modulus)) { return false; }
+        }
+    }
+    // modulo 1 every value is 0, which is its own inverse
+    Binary inverse(1, true);
+    if (!invert(inverse, Binary(5, true), Binary(1, true)) || inverse != 0) { return false; }
+    if (!invert(inverse, Binary(-5, true), Binary(-1, true)) || inverse != 0) { return false; }
+    const ModBinary one(Binary(5, true), ModBinary::make_context(Binary(1, true)));
+    if (one.inverse().value() != 0) { return false; }
+    return gcd(Binary(0, true), Binary(-12, true)) == Binary(12, true) && gcd(Binary(0, true), Binary(0, true)) == Binary(0, true);
+}
+
+bool UnitTests::Primes() {
+    // Montgomery exponentiation agrees with repeated multiplication, and with Fermat's little theorem for 2^127 - 1
+    std::mt19937_64 eng(41);
+    for (std::size_t limbs : {1, 2, 5}) {
+        natural::container_type m(limbs), x(limbs + 1);
+        for (auto& limb : m) { limb = eng(); }
+        for (auto& limb : x) { limb = eng(); }
+        m[0] |= 1;
+        const natural::container_type e = natural::from_limb(eng() % 1000);
+        const Montgomery mont(m);
+        natural::container_type expected = natural::from_limb(1), q;
+        for (kernels::limb_type i = 0; i < e[0]; ++i) {
+            natural::divrem(natural::mul(expected, x), m, q, expected);
+        }
+        if (mont.from_montgomery(mont.pow(mont.to_montgomery(x), e)) != expected) { return false; }
+    }
+    const natural::container_type m127 = natural::sub(natural::shl(natural::from_limb(1), 127), natural::from_limb(1));
+    const Montgomery mont(m127);
+    const natural::container_type e = natural::sub(m127, natural::from_limb(1));
+    if (mont.from_montgomery(mont.pow(mont.to_montgomery(natural::from_limb(12345)), e)) != natural::from_limb(1)) {
+        return false;
+    }
+
+    // small values, a Wieferich square that is a strong pseudoprime to base 2, Mersenne numbers
+    const Binary one(1, true);
+    std::vector<Binary> candidates;
+    std::vector<bool> expected;
+    for (int i = -3; i < 50; ++i) {
+        candidates.emplace_back(i, true);
+        bool prime = i >= 2;
+        for (int d = 2; d * d <= i; ++d) { prime = prime && i % d; }
+        expected.push_back(prime);
+    }
+    candidates.emplace_back(1093 * 1093, true);
+    expected.push_back(false);
+    for (std::uint64_t p : {61, 64, 89, 127, 128, 521}) {
+        Binary mersenne = Binary::from_magnitude(natural::shl(natural::from_limb(1), p), false) - one;
+        candidates.push_back(mersenne);
+        expected.push_back(p != 64 && p != 128);
+    }
+    const Binary m61 = candidates[candidates.size() - 6], m89 = candidates[candidates.size() - 4];
+    candidates.push_back(Binary::from_magnitude(natural::mul(m61.magnitude(), m89.magnitude()), false));
+    expected.push_back(false);
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        if (is_probable_prime(candidates[i]) != expected[i]) { return false; }
+    }
+    ThreadPool pool(4);
+    if (is_probable_prime(candidates, pool) != expected) { return false; }
+
+    // the primes following 2^64 and 2^128 are 2^64 + 13 and 2^128 + 51
+    for (std::size_t p : {64, 128}) {
+        const Binary power = Binary::from_magnitude(natural::shl(natural::from_limb(1), p), false);
+        const Binary prime = power + Binary(p == 64 ? 13 : 51, true);
+        if (next_prime(power) != prime || next_prime(power, pool) != prime) { return false; }
+        if (next_prime(prime - one) != prime || next_prime(prime) == prime) { return false; }
+    }
+    return next_prime(Binary(-5, true)) == Binary(2, true) && next_prime(Binary(2, true)) == Binary(3, true)
+           && next_prime(Binary(1021, true)) == Binary(1031, true) && next_prime(Binary(1048573, true), pool) == Binary(1048583, true);
+}
+
+bool UnitTests::RandomBinary() {
+    // reseeding repeats the stream, every bit position is set about half of the time
+    Random::seed(3);
+    const Binary first = Random::getBinary(4096);
+    Random::seed(3);
+    if (Random::getBinary(4096) != first || first.precision() != 4096) { return false; }
+    std::vector<int> counts(100, 0);
+    for (int i = 0; i < 2000; ++i) {
+        const Binary x = Random::getBinary(100);
+        if (x.precision() != 100) { return false; }
+        const auto limbs = x.to_limbs(2);
+        for (std::size_t b = 0; b < 100; ++b) { counts[b] += (limbs[b / 64] >> (b % 64)) & 1; }
+    }
+    for (const int count : counts) {
+        if (count < 850 || count > 1150) { return false; }
+    }
+
+    // values below a bound cover [0, bound) and keep its precision
+    const Binary bound(37, true);
+    std::vector<bool> seen(37, false);
+    for (int i = 0; i < 2000; ++i) {
+        const Binary x = Random::getBelow(bound);
+        if (x.sign() || !(x < bound) || x.precision() != bound.precision()) { return false; }
+        seen[x.to_limbs(1)[0]] = true;
+    }
+    for (const bool s : seen) {
+        if (!s) { return false; }
+    }
+    const Binary large = Random::getBinary(300).absVal();
+    for (int i = 0; i < 20; ++i) {
+        const Binary x = Random::getBelow(large);
+        if (x.sign() || !(x < large)) { return false; }
+    }
+
+    // threads draw from their own generators, which start from different seeds
+    Binary a, b;
+    std::thread ta([&] { a = Random::getBinary(256); }), tb([&] { b = Random::getBinary(256); });
+    ta.join();
+    tb.join();
+    bool thrown = false;
+    try { Random::getBelow(Binary(0, true)); } catch (const std::domain_error&) { thrown = true; }
+    if (!thrown) { return false; }
+    thrown = false;
+    try { Random::getBinary(0); } catch (const std::domain_error&) { thrown = true; }
+    return a != b && thrown;
+}
+
+bool UnitTests::Instrumentation() {
+    using instrumentation::Operation;
+    const Binary a(-1234567, true), b(89, true);
+    instrumentation::reset();
+    const Binary sum = a + b;
+    const Binary absolute = a.absVal();
+    const bool smaller = b < a;
+    Binary remainder(a);
+    remainder %= 1000;
+    const instrumentation::Snapshot counters = instrumentation::snapshot();
+    const auto& add = counters[static_cast<std::size_t>(Operation::Add)];
+    const auto& absval = counters[static_cast<std::size_t>(Operation::AbsVal)];
+    const auto& negate = counters[static_cast<std::size_t>(Operation::Negate)];
+    const auto& compare = counters[static_cast<std::size_t>(Operation::Compare)];
+    const auto& divide = counters[static_cast<std::size_t>(Operation::Divide)];
+    const auto& modulo = counters[static_cast<std::size_t>(Operation::Modulo)];
+
+    if (!instrumentation::enabled) {
+        // nothing is counted without the instrumentation
+        for (const auto& c : counters) {
+            if (c.calls || c.allocations) { return false; }
+        }
+        return sum == Binary(-1234478, true) && !smaller && absolute == Binary(1234567, true)
+               && remainder == Binary(-567, true);
+    }
+
+    // the negation inside absVal counts towards absVal, including its allocations
+    if (add.calls != 1 || add.operand_bits != a.precision() + b.precision() || add.allocations == 0) { return false; }
+    if (absval.calls != 1 || absval.allocations == 0 || negate.calls != 0 || compare.calls != 1) { return false; }
+    // the scalar operators count as their Binary counterparts
+    if (modulo.calls != 1 || modulo.allocated_bytes == 0 || divide.calls != 0) { return false; }
+    instrumentation::reset();
+    return instrumentation::snapshot()[static_cast<std::size_t>(Operation::Add)].calls == 0
+           && std::string(instrumentation::name(Operation::ShiftLeft)) == "shift_left";
+}
+
+bool UnitTests::Thresholds() {
+    // products do not depend on the thresholds, down to the smallest Karatsuba threshold
+    const thresholds::Table original = thresholds::get();
+    std::mt19937_64 eng(43);
+    natural::container_type a(150), b(150);
+    for (auto& limb : a) { limb = eng(); }
+    for (auto& limb : b) { limb = eng(); }
+    const natural::container_type product = natural::mul(a, b), square = natural::mul(a, a);
+
+    thresholds::Table table = original;
+    table.karatsuba_mul = table.karatsuba_sqr = 0;
+    thresholds::set(table);
+    const bool clamped = thresholds::get().karatsuba_mul == thresholds::min_karatsuba;
+    const bool low = natural::mul(a, b) == product && natural::mul(a, a) == square;
+    table.karatsuba_mul = table.karatsuba_sqr = std::numeric_limits<std::size_t>::max();
+    thresholds::set(table);
+    const bool high = natural::mul(a, b) == product && natural::mul(a, a) == square;
+    thresholds::set(original);
+
+    // tables survive a round trip through a file, malformed files are rejected
+    const std::string path = "lmpa_thresholds_test.txt";
+    table.karatsuba_mul = 40;
+    table.parallel_product = 12345;
+    {
+        std::ofstream file(path);
+        thresholds::write(file, table);
+    }
+    thresholds::Table loaded;
+    const bool read = thresholds::load(path, loaded) && loaded.karatsuba_mul == 40 && loaded.parallel_product == 12345;
+    {
+        std::ofstream file(path);
+        file << "karatsuba_mul forty\n";
+    }
+    const bool rejected = !thresholds::load(path, loaded) && loaded.karatsuba_mul == 40;
+    std::remove(path.c_str());
+    return clamped && low && high && read && rejected && !thresholds::load("missing_thresholds.txt", loaded);
+}
+
+bool UnitTests::LongDivision() {
+    // a = q * b + r with r < b, including divisors whose estimated quotient limbs need correction
+    std::mt19937_64 eng(11);
+    for (std::size_t an : {1, 2, 5, 40}) {
+        for (std::size_t bn : {1, 2, 3, 17}) {
+            natural::container_type a(an), b(bn);
+            for (auto& limb : a) { limb = eng(); }
+            for (auto& limb : b) { limb = eng(); }
+            b.back() = bn % 2 ? ~kernels::limb_type(0) : 1 + (eng() & 0xFF);
+            natural::normalize(a);
+
+            natural::container_type q, r;
+            natural::divrem(a, b, q, r);
+            if (natural::compare(r, b) >= 0) { return false; }
+            if (natural::compare(natural::add(natural::mul(q, b), r), a) != 0) { return false; }
+        }
+    }
+    return natural::sqrt(natural::from_limb(99)) == natural::from_limb(9);
+}
+
+bool UnitTests::DynamicStorage() {
+    // static Binaries still wrap around
+    Binary wrapped(std::numeric_limits<std::int32_t>::max(), true);
+    if (wrapped + Binary(1, true) != Binary(std::numeric_limits<std::int32_t>::min(), true)) { return false; }
+
+    // doubling grows in whole limbs
+    Binary power(1, true);
+    power.storage_type = Binary::StorageType::Dynamic;
+    for (int i = 0; i < 100; ++i) { power = power + power; }
+    if (power != Binary::from_magnitude(natural::shl(natural::from_limb(1), 100), false) || power.precision() != 128) {
+        return false;
+    }
+    Binary shifted(-3, true);
+    shifted.storage_type = Binary::StorageType::Dynamic;
+    shifted <<= 100;
+    if (shifted != -(power + power + power)) { return false; }
+
+    // 40! overflows 128 bits, the dynamic product holds it exactly
+    Binary fact(1, true);
+    fact.storage_type = Binary::StorageType::Dynamic;
+    for (int i = 2; i <= 40; ++i) { fact *= Binary(i, true); }
+    if (fact != factorial(40) || fact.precision() != 192) { return false; }
+
+    Binary small = Binary(-5, true) - fact;
+    if (small.storage_type != Binary::StorageType::Dynamic || small + fact != Binary(-5, true)) { return false; }
+
+    // the extreme values
+    Binary max(std::numeric_limits<std::int32_t>::max(), true), min(std::numeric_limits<std::int32_t>::min(), true);
+    max.storage_type = min.storage_type = Binary::StorageType::Dynamic;
+    ++max;
+    if (max.sign() || max != -min || (-min).sign()) { return false; }
+
+    // a dynamic floating point product is exact
+    Binary odd = power + Binary(1, true); // 2^100 + 1
+    LMPA x(odd, 101);
+    x.storage_type = LMPA::StorageType::Dynamic;
+    const LMPA square = x * x;
+    return square.precision() == 202 && square.to_binary() == odd * odd;
+}
+
+bool UnitTests::CheckedArithmetic() {
+    // at 32 bits, the results have to agree with 64 bit arithmetic on 32 bit values
+    std::mt19937_64 eng(33);
+    std::uniform_int_distribution<std::int32_t> dist(std::numeric_limits<std::int32_t>::min(),
+                                                     std::numeric_limits<std::int32_t>::max());
+    auto fits = [](std::int64_t x) {
+        return x >= std::numeric_limits<std::int32_t>::min() && x <= std::numeric_limits<std::int32_t>::max();
+    };
+    for (int i = 0; i < 1000; ++i) {
+        // small values as well, so that both outcomes are covered
+        const std::int32_t x = dist(eng) >> (i % 32), y = dist(eng) >> (i % 17);
+        const Binary a(x, true), b(y, true);
+        Binary sum, difference, product;
+        if (add_overflow(sum, a, b) == fits(std::int64_t(x) + y) || sum != a + b) { return false; }
+        if (sub_overflow(difference, a, b) == fits(std::int64_t(x) - y) || difference != a - b) { return false; }
+        if (mul_overflow(product, a, b) == fits(std::int64_t(x) * y) || product != a * b) { return false; }
+    }
+
+    // precisions which are not a multiple of the limb size, and the minimum value
+    Binary a(Binary::container_type(70, 0)), b(a), c(a);
+    a.reserve(100);
+    ++a;
+    a <<= 98; // 2^98
+    b = a;
+    --b; // 2^98 - 1
+    if (!add_overflow(c, a, a) || add_overflow(c, a, b) || !sub_overflow(c, -a, a + b) || sub_overflow(c, -a, a)) {
+        return false;
+    }
+    Binary half(100);
+    ++half;
+    half <<= 49; // 2^49
+    return !mul_overflow(c, half, -half - half) && mul_overflow(c, half, half + half) && mul_overflow(c, b, b);
+}
+
+bool UnitTests::ScalarArithmetic() {
+    // scalar operators agree with the Binary operators on the scalar's value, wrapped at the promoted precision
+    std::mt19937_64 eng(47);
+    const std::uint64_t scalars[] = {0, 1, 7, 1000000007, std::numeric_limits<std::uint64_t>::max(), 1ull << 63};
+    for (std::size_t prec : {8, 32, 64, 65, 100, 200}) {
+        for (int i = 0; i < 20; ++i) {
+            natural::container_type limbs(4);
+            for (auto& limb : limbs) { limb = eng(); }
+            Binary a;
+            a.assign_limbs(limbs, prec);
+            for (std::uint64_t u : scalars) {
+                const auto s = static_cast<std::int64_t>(eng() >> (eng() % 64)) * (i % 2 ? -1 : 1);
+                const Binary bu = Binary::from_magnitude(natural::from_limb(u), false, 66);
+                const Binary bs = Binary::from_magnitude(natural::from_limb(s < 0 ? 0 - std::uint64_t(s) : s), s < 0, 66);
+                const std::size_t p = std::max<std::size_t>(prec, 64);
+
+                Binary sum = a + bu, difference = a - bs, product = a * bu;
+                sum.set_precision(p);
+                difference.set_precision(p);
+                product.set_precision(p);
+                if (a + u != sum || (a + u).precision() != p || a - s != difference || a * u != product) { return false; }
+                if ((a < u) != (a < bu) || (a == s) != (a == bs) || (a >= s) != (a >= bs)) { return false; }
+                if (u != 0 && (a / u != a / bu || a % u != a % bu)) { return false; }
+                if (s != 0 && (a / s != a / bs || a % s != a % bs)) { return false; }
+            }
+        }
+    }
+
+    // dynamic Binaries grow instead of wrapping, small types promote to their own precision
+    Binary counter(0, true);
+    counter.storage_type = Binary::StorageType::Dynamic;
+    Binary expected = counter;
+    for (int i = 0; i < 5; ++i) {
+        counter += std::numeric_limits<std::uint64_t>::max();
+        counter *= -3;
+        counter -= std::numeric_limits<std::int64_t>::min();
+        expected = (expected + Binary::from_magnitude(natural::from_limb(~0ull), false, 66)) * Binary(-3, true)
+                   + Binary::from_magnitude(natural::from_limb(1ull << 63), false, 66);
+    }
+    Binary small(5);
+    small += 3;
+    Binary limit(std::numeric_limits<std::int32_t>::max(), true);
+    limit.storage_type = Binary::StorageType::Dynamic;
+    ++limit;
+    limit -= 1;
+    limit += 1;
+    bool thrown = false;
+    try { small /= 0u; } catch (const div_by_zero_error&) { thrown = true; }
+    return counter == expected && counter.precision() > 64 && small.precision() == 32 && small == 3
+           && limit == 2147483648ll && limit > std::numeric_limits<std::int32_t>::max() && thrown
+           && Binary(-7, true) / 2 == -3 && Binary(-7, true) % 2 == -1 && Binary(7, true) % -2 == 1;
+}
+
+bool UnitTests::InvariantDivisor() {
+    // the reciprocal division agrees with the plain single-limb division, in place and for all divisor shapes
+    std::mt19937_64 eng(53);
+    const kernels::limb_type divisors[] = {1, 2, 3, 10, 10000000000000000000ull, 1ull << 63, (1ull << 63) + 1,
+                                           ~kernels::limb_type(0), 614889782588491410ull, eng(), eng() >> 17};
+    for (const kernels::limb_type d : divisors) {
+        const DivisorU64 divisor(d);
+        for (std::size_t n : {0, 1, 2, 7, 40}) {
+            std::vector<kernels::limb_type> a(n), q(n), expected(n);
+            for (auto& limb : a) { limb = eng(); }
+            if (n > 1) { a[0] = ~kernels::limb_type(0); }
+            const kernels::limb_type r = kernels::divrem_1(expected.data(), a.data(), n, d);
+            if (divisor.divrem(q.data(), a.data(), n) != r || q != expected || divisor.mod(a.data(), n) != r) { return false; }
+            if (divisor.divrem(a.data(), a.data(), n) != r || a != expected) { return false; }
+        }
+        const kernels::limb_type two[2] = {eng(), eng() % d};
+        if (divisor.mod(two[1], two[0]) != divisor.mod(two, 2)) { return false; }
+    }
+
+    // Binary::divrem truncates and leaves the remainder's sign to the dividend
+    const DivisorU64 ten(10);
+    Binary x(-12345, true), y(987654321, true);
+    const kernels::limb_type rx = x.divrem(ten), ry = y.divrem(ten);
+    bool thrown = false;
+    try { DivisorU64 zero(0); } catch (const div_by_zero_error&) { thrown = true; }
+    return rx == 5 && x == -1234 && x.precision() == 32 && ry == 1 && y == 98765432 && thrown;
+}
+
+bool UnitTests::ExactDivision() {
+    // (q * d) / d = q limb by limb and halved, with trailing zeros and a divisor longer than q
+    std::mt19937_64 eng(45);
+    ThreadPool pool(4);
+    const auto random = [&](std::size_t n) {
+        natural::container_type x(n);
+        for (auto& limb : x) { limb = eng(); }
+        if (n) { x.back() |= 1; }
+        return x;
+    };
+    // the smallest Karatsuba threshold lets the halving of the quotient start at 128 divisor limbs
+    const thresholds::Table original = thresholds::get();
+    for (const std::size_t karatsuba : {original.karatsuba_mul, thresholds::min_karatsuba}) {
+        thresholds::Table table = original;
+        table.karatsuba_mul = karatsuba;
+        thresholds::set(table);
+        for (const std::size_t qn : {1, 2, 5, 31, 130, 700}) {
+            for (const std::size_t dn : {1, 3, 40, 300}) {
+                const natural::container_type q = random(qn);
+                const natural::container_type d = natural::shl(random(dn), qn % 70);
+                const natural::container_type a = natural::mul(q, d);
+                if (natural::divexact(a, d) != q || natural::divexact(a, d, &pool) != q) {
+                    thresholds::set(original);
+                    return false;
+                }
+            }
+        }
+    }
+    thresholds::set(original);
+    if (!natural::divexact(natural::container_type(), natural::from_limb(3)).empty()) { return false; }
+
+    // signs like a / b, the same with the pool, and growing with dynamic storage
+    const Binary x(-123456789, true), y(-9, true);
+    Binary big(1, true);
+    big.storage_type = Binary::StorageType::Dynamic;
+    big <<= 200;
+    bool thrown = false;
+    try { divexact(x, Binary(0, true)); } catch (const div_by_zero_error&) { thrown = true; }
+    return divexact(x, y) == 13717421 && divexact(-x, y) == -13717421 && divexact(x, y, pool) == x / y &&
+           divexact(big * 3, Binary(3, true)) == big && divexact(x, y).precision() == 32 && thrown;
+}
+
+bool UnitTests::ModularArithmetic() {
+    // residues agree with the canonical arithmetic modulo m, for the dynamic type and the compiled-in sizes
+    std::mt19937_64 eng(46);
+    const auto canonical = [](const natural::container_type& x, const natural::container_type& m) {
+        natural::container_type q, r;
+        natural::divrem(x, m, q, r);
+        return Binary::from_magnitude(r, false, natural::bit_length(m) + 1);
+    };
+    // 2^255 - 19, a 384 bit odd value and a 500 bit odd value
+    natural::container_type moduli[3] = {natural::sub(natural::shl(natural::from_limb(1), 255), natural::from_limb(19)),
+                                         natural::container_type(6), natural::container_type(8)};
+    for (auto& limb : moduli[1]) { limb = eng(); }
+    for (auto& limb : moduli[2]) { limb = eng(); }
+    moduli[1][0] |= 1;
+    moduli[2][0] |= 1;
+    moduli[2][7] >>= 12;
+
+    for (const natural::container_type& m : moduli) {
+        const Binary modulus = Binary::from_magnitude(m, false);
+        const ModBinary::context_type context = ModBinary::make_context(modulus);
+        const ModBinary256::context_type context256 = m.size() <= 4 ? ModBinary256::make_context(modulus) : nullptr;
+        const ModBinary384::context_type context384 = m.size() <= 6 ? ModBinary384::make_context(modulus) : nullptr;
+        const ModBinary512::context_type context512 = ModBinary512::make_context(modulus);
+        for (int i = 0; i < 20; ++i) {
+            natural::container_type a(m.size() + 1), b(m.size());
+            for (auto& limb : a) { limb = eng(); }
+            for (auto& limb : b) { limb = eng(); }
+            natural::normalize(a);
+            natural::normalize(b);
+            const Binary x = Binary::from_magnitude(a, false), y = Binary::from_magnitude(b, true);
+            const natural::container_type br = canonical(b, m).magnitude();
+            const natural::container_type yr = br.empty() ? br : natural::sub(m, br);
+            const natural::container_type xr = canonical(a, m).magnitude();
+
+            const Binary sum = canonical(natural::add(xr, yr), m);
+            const Binary difference = canonical(natural::sub(natural::add(xr, m), yr), m);
+            const Binary product = canonical(natural::mul(xr, yr), m);
+            const Binary square = canonical(natural::mul(xr, xr), m);
+            const Binary power = canonical(natural::mul(natural::mul(square.magnitude(), square.magnitude()), xr), m);
+
+            // the random moduli may share factors with x
+            const bool invertible = gcd(x, modulus) == 1;
+            const ModBinary p(x, context), q(y, context);
+            if ((p + q).value() != sum || (p - q).value() != difference || (p * q).value() != product) { return false; }
+            if (p.sqr().value() != square || p.pow(Binary(5, true)).value() != power) { return false; }
+            if ((-p + p).value() != 0 || p.pow(Binary(0, true)).value() != 1) { return false; }
+            if (invertible && ((p * p.inverse()).value() != 1 || p.pow(Binary(-1, true)) != p.inverse())) { return false; }
+
+            if (context256) {
+                const ModBinary256 f(x, context256), g(y, context256);
+                if ((f + g).value() != sum || (f - g).value() != difference || (f * g).value() != product) { return false; }
+                if (f.sqr().value() != square || f.pow(Binary(5, true)).value() != power) { return false; }
+                if (invertible && ((f * f.inverse()).value() != 1 || f.pow(Binary(-1, true)) != f.inverse())) { return false; }
+            }
+            if (context384) {
+                const ModBinary384 f(x, context384), g(y, context384);
+                if ((f * g).value() != product || (f - g).value() != difference) { return false; }
+            }
+            const ModBinary512 f(x, context512), g(y, context512);
+            if ((f + g).value() != sum || (f * g).value() != product || (-f).value() != canonical(natural::sub(m, xr), m)) {
+                return false;
+            }
+        }
+    }
+
+    // even moduli, mixed moduli and residues without inverse are rejected
+    int thrown = 0;
+    try { ModBinary::make_context(Binary(10, true)); } catch (const std::domain_error&) { ++thrown; }
+    try { ModBinary256::make_context(Binary::from_magnitude(moduli[1], false)); } catch (const std::domain_error&) { ++thrown; }
+    const ModBinary three(Binary(3, true), ModBinary::make_context(Binary(9, true)));
+    try { three.inverse(); } catch (const std::domain_error&) { ++thrown; }
+    try { (void) (three + ModBinary(Binary(3, true), ModBinary::make_context(Binary(7, true)))); } catch (const std::domain_error&) { ++thrown; }
+    return thrown == 4 && (three * three).value() == 0;
+}
+
+bool UnitTests::ResidueNumberSystem() {
+    // sums, differences and products of values of up to 600 bits reconstruct exactly in a basis of 1300 bits
+    std::mt19937_64 eng(47);
+    ThreadPool pool(4);
+    const RNSBinary::basis_type basis = RNSBasis::with_precision(1300);
+    if (basis->capacity() < 1300 || basis->size() != 21) { return false; }
+    const auto random = [&](std::size_t limbs, bool negative) {
+        natural::container_type x(limbs);
+        for (auto& limb : x) { limb = eng(); }
+        natural::normalize(x);
+        return Binary::from_magnitude(x, negative);
+    };
+    // the exact result of a op b for signed magnitudes
+    const auto exact = [](const Binary& a, const Binary& b, bool subtract) {
+        const bool sb = b.sign() != subtract;
+        if (a.sign() == sb) { return Binary::from_magnitude(natural::add(a.magnitude(), b.magnitude()), a.sign()); }
+        if (natural::compare(a.magnitude(), b.magnitude()) >= 0) {
+            return Binary::from_magnitude(natural::sub(a.magnitude(), b.magnitude()), a.sign());
+        }
+        return Binary::from_magnitude(natural::sub(b.magnitude(), a.magnitude()), sb);
+    };
+    for (int i = 0; i < 20; ++i) {
+        const Binary a = random(1 + i % 9, i % 2), b = random(1 + i % 7, i % 3 == 0);
+        const RNSBinary x(a, basis), y(b, basis, pool);
+        const Binary product = Binary::from_magnitude(natural::mul(a.magnitude(), b.magnitude()), a.sign() != b.sign());
+        if (x.to_binary() != a || y.to_binary() != b || (-x).to_binary() != exact(Binary(0, true), a, true)) { return false; }
+        if ((x + y).to_binary() != exact(a, b, false) || (x - y).to_binary() != exact(a, b, true)) { return false; }
+        if ((x * y).to_binary() != product || multiply(x, y, pool) != x * y) { return false; }
+        if (add(x, y, pool) != x + y || subtract(x, y, pool) != x - y) { return false; }
+    }
+
+    // explicit primes, where 3 * 5 * 7 = 105 holds -52 to 52 and wraps beyond
+    const RNSBinary::basis_type small = std::make_shared<const RNSBasis>(RNSBasis::container_type{3, 5, 7});
+    const RNSBinary u(Binary(-52, true), small), w(Binary(2, true), small);
+    if (u.to_binary() != -52 || (u - w).to_binary() != 51 || (u * w).to_binary() != 1 || small->capacity() != 6) {
+        return false;
+    }
+    int thrown = 0;
+    try { RNSBasis(RNSBasis::container_type{3, 9}); } catch (const std::domain_error&) { ++thrown; }
+    try { RNSBasis(RNSBasis::container_type{5, 5}); } catch (const std::domain_error&) { ++thrown; }
+    try { (void) (u + RNSBinary(Binary(1, true), basis)); } catch (const std::domain_error&) { ++thrown; }
+    return thrown == 3;
+}
+
+bool UnitTests::SignMagnitude() {
+    // every operation agrees with the same operation on 64 bit integers, including the bitwise ones on negative values
+    std::mt19937_64 eng(48);
+    for (int i = 0; i < 1000; ++i) {
+        const auto x = static_cast<std::int64_t>(eng()) >> (eng() % 40 + 24);
+        auto y = static_cast<std::int64_t>(eng()) >> (eng() % 20 + 44);
+        if (y == 0) { y = -7; }
+        const unsigned n = eng() % 16;
+        const SignMagnitudeBinary a(x), b(y);
+        if (a + b != SignMagnitudeBinary(x + y) || a - b != SignMagnitudeBinary(x - y)) { return false; }
+        if (a * b != SignMagnitudeBinary(x * y) || a / b != SignMagnitudeBinary(x / y) || a % b != SignMagnitudeBinary(x % y)) {
+            return false;
+        }
+        if ((a & b) != SignMagnitudeBinary(x & y) || (a | b) != SignMagnitudeBinary(x | y)) { return false; }
+        if ((a ^ b) != SignMagnitudeBinary(x ^ y) || ~a != SignMagnitudeBinary(~x)) { return false; }
+        if ((a >> n) != SignMagnitudeBinary(x >> n) || (a << n) != SignMagnitudeBinary(x * (std::int64_t(1) << n))) { return false; }
+        if ((a < b) != (x < y) || (a >= b) != (x >= y) || (-a).to_binary(64) != Binary(-x, true)) { return false; }
+    }
+
+    // magnitudes beyond a limb, and conversions keeping the value
+    Binary big(1, true);
+    big.storage_type = Binary::StorageType::Dynamic;
+    big <<= 130;
+    big = -big;
+    SignMagnitudeBinary s(big);
+    if (s.precision() != 131 || s.to_binary(1) != big || s.to_binary(1).precision() != 132) { return false; }
+    s -= SignMagnitudeBinary(1);
+    if (s.precision() != 132 || (s.absVal() + s).is_zero() == false || SignMagnitudeBinary(0).negate().sign()) { return false; }
+
+    std::ostringstream stream;
+    stream << SignMagnitudeBinary(-5);
+    bool thrown = false;
+    try { s / SignMagnitudeBinary(0); } catch (const div_by_zero_error&) { thrown = true; }
+    return stream.str() == "-0b0101" && thrown;
+}
+
+bool UnitTests::CopyOnWrite() {
+    Binary a(1, true);
+    a.storage_type = Binary::StorageType::Dynamic;
+    a <<= 5000;
+    a -= Binary(12345, true);
+    const Binary expected = a;
+    a.set_copy_mode(Binary::CopyModes::Shared);
+    if (a != expected || expected.copy_mode() != Binary::CopyModes::Deep) { return false; }
+
+    // copies share the mode, writes to either side leave the other untouched
+    Binary b = a;
+    b += Binary(1, true);
+    if (b.copy_mode() != Binary::CopyModes::Shared || a != expected || b != expected + Binary(1, true)) { return false; }
+    Binary c = +a;
+    const Binary d = c++;
+    ++c;
+    if (d != expected || c != expected + Binary(2, true) || a.absVal() != expected || a != expected) { return false; }
+
+    // assigned-to objects keep their mode, and leaving the shared mode keeps the value
+    Binary e(64);
+    e = a;
+    e.set_copy_mode(Binary::CopyModes::Shared);
+    e = expected - Binary(1, true);
+    if (e.copy_mode() != Binary::CopyModes::Shared || e != expected - Binary(1, true)) { return false; }
+    e.set_copy_mode(Binary::CopyModes::Deep);
+    if (e.copy_mode() != Binary::CopyModes::Deep || e != expected - Binary(1, true)) { return false; }
+    Binary moved(64);
+    Binary shared_copy = a;
+    moved = std::move(shared_copy);
+    if (moved.copy_mode() != Binary::CopyModes::Deep || moved != expected || a != expected) { return false; }
+
+    // concurrent copies and reads of the same value, every thread writing to its own copies
+    ThreadPool pool(4);
+    std::vector<ThreadPool::handle_type> tasks;
+    std::atomic<bool> failed(false);
+    for (int t = 0; t < 16; ++t) {
+        tasks.emplace_back(pool.submit([&a, &expected, &failed, t] {
+            for (int i = 0; i < 50; ++i) {
+                Binary copy = a;
+                Binary other(copy);
+                copy += Binary(t, true);
+                if (copy != expected + Binary(t, true) || other != a || a.magnitude() != expected.magnitude()) {
+                    failed = true;
+                }
+            }
+        }));
+    }
+    for (const ThreadPool::handle_type& task : tasks) {
+        pool.wait(task);
+    }
+    return !failed && a == expected;
+}
+
+bool UnitTests::Summation() {
+    // with the widest value first, static values of mixed precisions and signs wrap like a chain of +=,
+    // dynamic ones grow like it
+    std::mt19937_64 eng(50);
+    std::vector<Binary> values, dynamic;
+    for (int i = 0; i < 2000; ++i) {
+        Binary x(static_cast<std::int64_t>(eng()) >> (eng() % 60), true);
+        if (i % 3 == 0) { x.set_precision(128 + eng() % 200); x <<= eng() % 100; }
+        values.emplace_back(x);
+        x.storage_type = Binary::StorageType::Dynamic;
+        x <<= eng() % 300;
+        dynamic.emplace_back(x);
+    }
+    Binary chain = values.front(), dynamic_chain = dynamic.front();
+    for (std::size_t i = 1; i < values.size(); ++i) {
+        chain += values[i];
+        dynamic_chain += dynamic[i];
+    }
+    const Binary total = sum(std::begin(values), std::end(values));
+    const Binary dynamic_total = sum(std::begin(dynamic), std::end(dynamic));
+    if (total != chain || total.precision() != chain.precision()) { return false; }
+    if (dynamic_total != dynamic_chain || dynamic_total.storage_type != Binary::StorageType::Dynamic) { return false; }
+
+    // a narrow prefix that overflows on its own does not wrap, only the sum in the widest precision does
+    const std::vector<Binary> narrow{Binary(std::int8_t(127), true), Binary(std::int8_t(1), true), Binary(std::int16_t(0), true)};
+    const Binary widened = sum(std::begin(narrow), std::end(narrow));
+    if (widened != 128 || widened.precision() != 16) { return false; }
+    const std::vector<Binary> wrapping{Binary(std::int16_t(32767), true), Binary(std::int8_t(1), true)};
+    if (sum(std::begin(wrapping), std::end(wrapping)) != std::numeric_limits<std::int16_t>::min()) { return false; }
+
+    // parallel sums merge the same partial sums
+    ThreadPool pool(4);
+    const Binary parallel = sum(std::begin(dynamic), std::end(dynamic), pool);
+    if (parallel != dynamic_total || parallel.precision() != dynamic_total.precision()) { return false; }
+    if (sum(std::begin(values), std::end(values), pool) != chain) { return false; }
+
+    // subtracting every value again leaves 0 in the precision of the widest
+    BinaryAccumulator accumulator, other;
+    for (const Binary& x : dynamic) {
+        accumulator += x;
+        other -= x;
+    }
+    accumulator += other;
+    const Binary zero = accumulator.value();
+    accumulator.clear();
+    return zero == 0 && zero.precision() <= 512 && accumulator.value() == Binary() && sum(std::begin(values), std::begin(values)) == 0;
+}
+
+bool UnitTests::Floating() {
+    // at 53 bits and rounding to nearest, every operation has to match IEEE double arithmetic
+    std::mt19937_64 eng(53);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (int i = 0; i < 1000; ++i) {
+        const double x = dist(eng) * (i % 2 ? 1e-9 : 1);
+        const double y = dist(eng);
+        const LMPA a = LMPA::from_double(x), b = LMPA::from_double(y);
+        if ((a + b).to_double() != x + y || (a - b).to_double() != x - y) { return false; }
+        if ((a * b).to_double() != x * y || (a / b).to_double() != x / y) { return false; }
+        if (a.absVal().sqrt().to_double() != std::sqrt(std::fabs(x))) { return false; }
+        if ((a < b) != (x < y) || (a == b) != (x == y)) { return false; }
+    }
+
+    // 1/3 = 0b0.0101..., at 4 bits 0b1010p-5 or 0b1011p-5 depending on the direction
+    LMPA one(Binary(1, true), 4, LMPA::RoundingModes::Toward_Zero);
+    LMPA three(Binary(3, true), 4);
+    LMPA down = one / three;
+    one.rounding = LMPA::RoundingModes::Toward_Positive;
+    LMPA up = one / three;
+    if (down.mantissa() != Binary(10, true) || up.mantissa() != Binary(11, true) || up.exponent() != -5) { return false; }
+
+    // sqrt(2) to 200 bits, squared, is 2 within an ulp
+    LMPA two(Binary(2, true), 200);
+    LMPA root = two.sqrt();
+    LMPA error = (root * root - two).absVal();
+    if (!(error < LMPA::from_double(std::ldexp(1.0, -195)))) { return false; }
+
+    // just below the smallest normal double, truncation toward zero keeps to the subnormals
+    const LMPA unit(Binary(1, true), 120);
+    const LMPA below_min = unit.ldexp(-1022) - unit.ldexp(-1082);
+    if (below_min.to_double() != std::nextafter(DBL_MIN, 0.0) || (-below_min).to_double() != -std::nextafter(DBL_MIN, 0.0)) {
+        return false;
+    }
+    if ((unit.ldexp(-1074) + unit.ldexp(-1075)).to_double() != std::ldexp(1.0, -1074) || unit.ldexp(-1080).to_double() != 0) {
+        return false;
+    }
+
+    // integral arguments are precisions
+    const LMPA precise(64);
+    if (precise.precision() != 64 || !precise.is_zero()) { return false; }
+    return LMPA::from_double(-7.9).to_binary() == Binary(-7, true) && LMPA::from_double(1e30).to_binary() > Binary(1000000, true);
+}
+
+bool UnitTests::FixedPoint() {
+    typedef ::FixedPoint<32, 16> Fixed;
+
+    // values with at most 16 fractional bits are exact
+    const Fixed a(1.5), b(2.25), c(-3.0);
+    if ((a + b).to_double() != 3.75 || (a - b).to_double() != -0.75) { return false; }
+    if ((a * b).to_double() != 3.375 || (b * c).to_double() != -6.75) { return false; }
+    if ((Fixed(7.0) / Fixed(2.0)).to_double() != 3.5 || (c / a).to_double() != -2.0) { return false; }
+    if (!(c < a) || !(a < b) || a != Fixed(1.5) || Fixed(Binary(-3, true)) != c) { return false; }
+
+    // multiplication and division truncate toward zero
+    const Fixed third = Fixed(1.0) / Fixed(3.0);
+    if (third.raw() != Binary(21845, true) || (-Fixed(1.0) / Fixed(3.0)).raw() != Binary(-21845, true)) { return false; }
+    if ((third * Fixed(-3.0)).to_binary() != Binary(0, true)) { return false; }
+    if (Fixed(-7.75).to_binary() != Binary(-7, true)) { return false; }
+
+    // compound operators and wrapping at IntBits
+    Fixed x(1.0);
+    for (int i = 0; i < 30; ++i) { x *= Fixed(2.0); }
+    x += x;
+    if (!x.sign() || x + x != Fixed(0.0)) { return false; }
+
+    std::stringstream stream;
+    stream << Fixed(-5.375);
+    // more fractional bits than a double has exponent range
+    typedef ::FixedPoint<16, 1100> Fine;
+    const Fine fine(-2.25);
+    if (fine.raw() != -(Binary(9, true) << 1098) || fine.to_double() != -2.25) { return false; }
+    return stream.str() == "-0b101.0110000000000000";
+}
+
 bool UnitTests::Other() {
     // dynamically test += vs * etc.
 //    Binary a({0, 1, 0}); // 2
@@ -29,6 +29,36 @@ private:
 
     static bool SmallerThan();
 
+    /// Kernels ///
+    static bool Kernels();
+    static bool Batch();
+    static bool Karatsuba();
+    static bool Squaring();
+    static bool ParallelMultiply();
+    static bool Products();
+    static bool Powers();
+    static bool Roots();
+    static bool GCD();
+    static bool Primes();
+    static bool RandomBinary();
+    static bool Instrumentation();
+    static bool Thresholds();
+    static bool LongDivision();
+    static bool DynamicStorage();
+    static bool CheckedArithmetic();
+    static bool ScalarArithmetic();
+    static bool InvariantDivisor();
+    static bool ExactDivision();
+    static bool ModularArithmetic();
+    static bool ResidueNumberSystem();
+    static bool SignMagnitude();
+    static bool CopyOnWrite();
+    static bool Summation();
+
+    /// Floating Point ///
+    static bool Floating();
+    static bool FixedPoint();
+
     static bool Other();
 
 
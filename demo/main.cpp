@@ -4,25 +4,10 @@
 #include "../LMPA/LMPA.h"
 #include "../LMPA/Binary.h"
 
-#include <chrono> // benchmarking
-
 #include "Random.h" // randomized testing
 
-#include <functional>
-
 #include "UnitTests.h"
 
-typedef long long int time_type;
-
-template<typename T, typename... Args>
-time_type benchmark(T function, Args&&... args) {
-    // call with std::bind to use this on class member functions
-    auto starttime = std::chrono::high_resolution_clock::now();
-    function(std::forward<Args>(args)...);
-    auto endtime = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(endtime - starttime).count();
-}
-
 int main() {
 
     UnitTests::run();